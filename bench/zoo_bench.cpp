@@ -0,0 +1,212 @@
+// Нагрузка для сбора профиля PGO и замера скорости: большой зоопарк со
+// вспышками болезней, скрещиванием, покупками и продажей животных
+#include "policy.h"
+
+namespace {
+
+// Параметры нагрузки
+struct Workload {
+    int runs = 4;               // Зоопарков за повтор
+    int days = 300;             // Дней в каждом зоопарке
+    int maxPens = 60;           // Вольеров, после которых потомство не расселяется
+    unsigned seed = 1;          // Зерно первого зоопарка
+    int repeat = 5;             // Повторов замера (берется медиана)
+};
+
+// Скрещивание первой подходящей пары в каждом вольере; потомству при
+// необходимости строится новый вольер, пока их меньше maxPens
+void breedAll(Zoo& zoo, int maxPens) {
+    vector<AnimalPtr> born;
+    for (Pen& pen : zoo.getPens()) {
+        AnimalPtr male;
+        AnimalPtr female;
+        for (const auto& a : pen.getAnimals()) {
+            if (!a->canReproduce(zoo.getDay())) continue;
+            if (a->getGender() == MALE && !male) male = a;
+            if (a->getGender() == FEMALE && !female) female = a;
+        }
+        if (!male || !female) continue;
+        AnimalPtr child = Animal::breed(male, female, zoo.getDay());
+        if (child) born.push_back(child);
+    }
+    for (const auto& child : born) {
+        Pen* pen = zoo.findPenFor(child);
+        if (!pen) {
+            if (static_cast<int>(zoo.getPens().size()) >= maxPens) continue;
+            if (!zoo.buildPen(40, child->getType(), child->getClimate())) continue;
+            pen = &zoo.getPens().back();
+        }
+        pen->addAnimal(child);
+        zoo.getGenetics().record(*child);
+    }
+}
+
+// Продажа самого старого животного из заполненных вольеров
+void sellOldest(Zoo& zoo) {
+    for (int p = 0; p < static_cast<int>(zoo.getPens().size()); ++p) {
+        Pen& pen = zoo.getPens()[p];
+        if (pen.getAnimalCount() * 4 < pen.getCapacity() * 3) continue;
+        const vector<AnimalPtr>& animals = pen.getAnimals();
+        int oldest = 0;
+        for (int i = 1; i < static_cast<int>(animals.size()); ++i) {
+            if (animals[i]->getBirthDay() < animals[oldest]->getBirthDay()) oldest = i;
+        }
+        zoo.sellAnimal(p, oldest);
+    }
+}
+
+// Сценарий и автопилот нагрузки
+Scenario benchScenario(int days) {
+    Scenario sc;
+    sc.startMoney = 200000;
+    sc.maxDays = days;
+    sc.infectionChance = 45;
+    sc.maxAge = 150;
+    sc.spreadCount = 3;
+    return sc;
+}
+
+Policy benchPolicy() {
+    Policy policy;
+    policy.penCapacity = 40;
+    policy.foodDays = 2;
+    policy.advertising = 50;
+    policy.vetRatio = 0.5;
+    policy.cleanerRatio = 0.5;
+    return policy;
+}
+
+// Один день нагрузки: автопилот, скрещивание, продажа и ход
+void playDay(Zoo& zoo, const Policy& policy, int maxPens) {
+    size_t pensBefore = zoo.getPens().size();
+    PolicyPilot::act(zoo, policy);
+    breedAll(zoo, maxPens);
+    if (zoo.getDay() % 5 == 0) sellOldest(zoo);
+    // Новые вольеры соединяются с предыдущим, болезнь переходит между ними
+    for (size_t p = max<size_t>(pensBefore, 1); p < zoo.getPens().size(); ++p) {
+        zoo.togglePenLink(static_cast<int>(p) - 1, static_cast<int>(p));
+    }
+    zoo.nextDay();
+}
+
+// Контрольная сумма состояния зоопарка
+double checksumOf(const Zoo& zoo) {
+    return zoo.getMoney() - zoo.getDebt() + zoo.totalAnimals() + zoo.getDay();
+}
+
+// Один зоопарк; возвращает контрольную сумму состояния в конце игры
+double playZoo(const Workload& w, unsigned seed) {
+    zooSeed(seed);
+    Policy policy = benchPolicy();
+    Zoo zoo(L"Нагрузка", L"Директор", benchScenario(w.days));
+    while (!zoo.isOver()) playDay(zoo, policy, w.maxPens);
+    return checksumOf(zoo);
+}
+
+// Ветки одного зоопарка, прожившего w.days дней: branches веток по days дней.
+// deepCopy - ветки сразу копируют всех животных (как полная копия зоопарка),
+// иначе животные копируются по вольерам при изменении (Zoo::fork).
+// Возвращает время веток в мс
+double playBranches(const Workload& w, int branches, int days, bool deepCopy, double& checksum) {
+    zooSeed(w.seed);
+    Policy policy = benchPolicy();
+    Zoo zoo(L"Нагрузка", L"Директор", benchScenario(w.days + days));
+    while (zoo.getDay() < w.days && !zoo.isOver()) playDay(zoo, policy, w.maxPens);
+
+    auto started = chrono::steady_clock::now();
+    vector<unique_ptr<Zoo>> forks;
+    for (int b = 0; b < branches; ++b) {
+        forks.emplace_back(new Zoo(zoo.fork()));
+        if (deepCopy) forks.back()->ownPens();
+    }
+    checksum = 0.0;
+    for (int b = 0; b < branches; ++b) {
+        Zoo& branch = *forks[b];
+        zooSeed(w.seed + 1 + b);
+        for (int d = 0; d < days && !branch.isOver(); ++d) playDay(branch, policy, w.maxPens);
+        checksum += checksumOf(branch);
+    }
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - started).count();
+}
+
+// Один повтор: все зоопарки подряд
+double playAll(const Workload& w, double& checksum) {
+    auto started = chrono::steady_clock::now();
+    checksum = 0.0;
+    for (int r = 0; r < w.runs; ++r) {
+        checksum += playZoo(w, w.seed + r);
+    }
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - started).count();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Workload w;
+    bool train = false;         // Прогон для сбора профиля: без замеров
+    int branches = 0;           // Замер веток: число веток (0 - обычный замер)
+    int branchDays = 30;        // Дней в каждой ветке
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--train") {
+            train = true;
+        }
+        else if (arg == "--runs" && i + 1 < argc) {
+            w.runs = max(atoi(argv[++i]), 1);
+        }
+        else if (arg == "--days" && i + 1 < argc) {
+            w.days = max(atoi(argv[++i]), 1);
+        }
+        else if (arg == "--seed" && i + 1 < argc) {
+            w.seed = static_cast<unsigned>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "--repeat" && i + 1 < argc) {
+            w.repeat = max(atoi(argv[++i]), 1);
+        }
+        else if (arg == "--branches" && i + 1 < argc) {
+            branches = max(atoi(argv[++i]), 1);
+        }
+        else if (arg == "--branch-days" && i + 1 < argc) {
+            branchDays = max(atoi(argv[++i]), 1);
+        }
+    }
+    zooQuiet() = true;
+
+    if (train) {
+        double checksum;
+        double ms = playAll(w, checksum);
+        wcout << L"train runs=" << w.runs << L" days=" << w.days << L" ms=" << static_cast<long long>(ms) << endl;
+        return 0;
+    }
+
+    if (branches > 0) {
+        vector<double> forkTimes;
+        vector<double> copyTimes;
+        double forkChecksum = 0.0;
+        double copyChecksum = 0.0;
+        for (int k = 0; k < w.repeat; ++k) {
+            forkTimes.push_back(playBranches(w, branches, branchDays, false, forkChecksum));
+            copyTimes.push_back(playBranches(w, branches, branchDays, true, copyChecksum));
+        }
+        sort(forkTimes.begin(), forkTimes.end());
+        sort(copyTimes.begin(), copyTimes.end());
+        wcout << L"branches=" << branches << L" days=" << w.days << L"+" << branchDays << L" repeat=" << w.repeat
+            << L" fork_median_ms=" << fixed << setprecision(1) << forkTimes[forkTimes.size() / 2]
+            << L" copy_median_ms=" << copyTimes[copyTimes.size() / 2]
+            << L" checksum=" << setprecision(2) << forkChecksum
+            << (forkChecksum == copyChecksum ? L"" : L" (копии разошлись!)") << endl;
+        return forkChecksum == copyChecksum ? 0 : 1;
+    }
+
+    vector<double> times;
+    double checksum = 0.0;
+    for (int k = 0; k < w.repeat; ++k) {
+        times.push_back(playAll(w, checksum));
+    }
+    sort(times.begin(), times.end());
+    wcout << L"bench runs=" << w.runs << L" days=" << w.days << L" repeat=" << w.repeat
+        << L" median_ms=" << static_cast<long long>(times[times.size() / 2])
+        << L" min_ms=" << static_cast<long long>(times.front())
+        << L" checksum=" << fixed << setprecision(2) << checksum << endl;
+    return 0;
+}
@@ -0,0 +1,1129 @@
+// Консольная игра: меню, экран и разбор аргументов командной строки
+#include "policy.h"
+#include "sweep.h"
+#include "reference.h"
+#include "world.h"
+
+// Буфер вывода, считающий строки, напечатанные после последнего кадра
+class LineCountingBuf : public wstreambuf {
+private:
+    wstreambuf* target;         // Исходный буфер потока
+    int columns;                // Ширина терминала
+    int column = 0;             // Текущая колонка
+    int lines = 0;              // Напечатано строк (с учетом переноса)
+
+    void count(wchar_t c) {
+        if (c == L'\n' || ++column >= columns) {
+            lines++;
+            column = 0;
+        }
+    }
+
+protected:
+    int_type overflow(int_type c) override {
+        if (traits_type::eq_int_type(c, traits_type::eof())) return traits_type::not_eof(c);
+        count(traits_type::to_char_type(c));
+        return target->sputc(traits_type::to_char_type(c));
+    }
+
+    streamsize xsputn(const wchar_t* text, streamsize n) override {
+        for (streamsize i = 0; i < n; ++i) count(text[i]);
+        return target->sputn(text, n);
+    }
+
+    int sync() override {
+        return target->pubsync();
+    }
+
+public:
+    LineCountingBuf(wstreambuf* t, int cols) : target(t), columns(max(cols, 1)) {}
+
+    int getLines() const { return lines; }
+    void setColumns(int cols) { columns = max(cols, 1); }
+    void reset() { lines = 0; column = 0; }
+    void addLines(int n) { lines += n; }
+};
+
+// Обрезка строки до ширины терминала в экранных колонках, чтобы каждая
+// строка кадра занимала ровно одну строку экрана
+wstring clipToWidth(const wstring& line, int width) {
+    int used = 0;
+    for (size_t i = 0; i < line.size(); ++i) {
+#ifdef _WIN32
+        int w = 1;
+#else
+        int w = max(wcwidth(line[i]), 0);
+#endif
+        if (used + w > width) return line.substr(0, i);
+        used += w;
+    }
+    return line;
+}
+
+// Буфер ввода, считающий строки, введенные пользователем (эхо терминала)
+class InputLineCountingBuf : public wstreambuf {
+private:
+    wstreambuf* source;         // Исходный буфер потока
+    LineCountingBuf& counter;   // Общий счетчик строк экрана
+    wchar_t current = 0;        // Буфер на один символ
+
+protected:
+    int_type underflow() override {
+        int_type c = source->sbumpc();
+        if (traits_type::eq_int_type(c, traits_type::eof())) return c;
+        current = traits_type::to_char_type(c);
+        if (current == L'\n') counter.addLines(1);
+        setg(&current, &current, &current + 1);
+        return c;
+    }
+
+public:
+    InputLineCountingBuf(wstreambuf* s, LineCountingBuf& c) : source(s), counter(c) {}
+};
+
+// Модель экрана: хранит предыдущий кадр и перерисовывает только изменившиеся
+// строки с помощью управляющих последовательностей ANSI. Если вывод после кадра
+// мог прокрутить терминал, кадр перерисовывается целиком
+class Screen {
+private:
+    vector<wstring> previous;   // Предыдущий кадр
+    bool ansi = false;          // Поддерживает ли терминал ANSI
+    bool needFull = true;       // Требуется полная перерисовка
+    int rows = 24;              // Высота терминала
+    int columns = 80;           // Ширина терминала
+    wstreambuf* originalOut = nullptr;
+    wstreambuf* originalIn = nullptr;
+    unique_ptr<LineCountingBuf> outCounter;
+    unique_ptr<InputLineCountingBuf> inCounter;
+
+    // Определение размеров и возможностей терминала
+    void detectTerminal() {
+#ifdef _WIN32
+        HANDLE handle = GetStdHandle(STD_OUTPUT_HANDLE);
+        DWORD mode = 0;
+        if (handle != INVALID_HANDLE_VALUE && GetConsoleMode(handle, &mode)) {
+            ansi = SetConsoleMode(handle, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING) != 0;
+            CONSOLE_SCREEN_BUFFER_INFO info;
+            if (GetConsoleScreenBufferInfo(handle, &info)) {
+                rows = info.srWindow.Bottom - info.srWindow.Top + 1;
+                columns = info.srWindow.Right - info.srWindow.Left + 1;
+            }
+        }
+#else
+        ansi = isatty(STDOUT_FILENO) != 0;
+        winsize size;
+        if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_row > 0) {
+            rows = size.ws_row;
+            columns = size.ws_col;
+        }
+#endif
+    }
+
+public:
+    Screen() {
+        detectTerminal();
+        if (ansi) {
+            originalOut = wcout.rdbuf();
+            originalIn = wcin.rdbuf();
+            outCounter.reset(new LineCountingBuf(originalOut, columns));
+            inCounter.reset(new InputLineCountingBuf(originalIn, *outCounter));
+            wcout.rdbuf(outCounter.get());
+            wcin.rdbuf(inCounter.get());
+        }
+    }
+
+    ~Screen() {
+        if (ansi) {
+            wcout.flush();
+            wcout.rdbuf(originalOut);
+            wcin.rdbuf(originalIn);
+        }
+    }
+
+    Screen(const Screen&) = delete;
+    Screen& operator=(const Screen&) = delete;
+
+    // Принудительная полная перерисовка следующего кадра
+    void invalidate() { needFull = true; }
+
+    // Вывод кадра
+    void render(const vector<wstring>& frame) {
+        if (!ansi) {
+#ifdef _WIN32
+            system("cls");
+#endif
+            for (const auto& line : frame) wcout << line << L'\n';
+            wcout.flush();
+            previous = frame;
+            return;
+        }
+
+        // Размер окна мог измениться: старый кадр тогда переносится иначе
+        int oldColumns = columns;
+        detectTerminal();
+        if (columns != oldColumns) {
+            outCounter->setColumns(columns);
+            needFull = true;
+        }
+
+        // Длинные строки обрезаются, иначе перенос сдвинет номера строк
+        // экрана относительно номеров строк кадра
+        vector<wstring> clipped;
+        clipped.reserve(frame.size());
+        for (const auto& line : frame) clipped.push_back(clipToWidth(line, columns - 1));
+
+        // Вывод после прошлого кадра мог прокрутить экран
+        int used = static_cast<int>(previous.size()) + outCounter->getLines();
+        if (used >= rows - 1) needFull = true;
+
+        if (needFull) {
+            wcout << L"\x1b[H\x1b[2J";
+            for (const auto& line : clipped) wcout << line << L'\n';
+        }
+        else {
+            for (size_t i = 0; i < clipped.size(); ++i) {
+                if (i >= previous.size() || previous[i] != clipped[i]) {
+                    wcout << L"\x1b[" << (i + 1) << L";1H" << clipped[i] << L"\x1b[K";
+                }
+            }
+            // Очистка вывода прошлого действия под кадром
+            wcout << L"\x1b[" << (clipped.size() + 1) << L";1H\x1b[J";
+        }
+        wcout.flush();
+
+        previous = clipped;
+        needFull = false;
+        outCounter->reset();
+    }
+};
+
+// Ожидание нажатия Enter (вместо system("pause"))
+void waitForEnter() {
+    wcout << L"Нажмите Enter для продолжения...";
+    wstring line;
+    getline(wcin, line);
+}
+
+// Вывод итога игры, возвращает код завершения процесса
+int showGameResult(const Zoo& zoo) {
+    switch (zoo.getStatus()) {
+    case VICTORY:
+        wcout << L"Поздравляем! Вы успешно завершили игру за " << zoo.getMaxDays() << L" дней!\n";
+        return 0;
+    case BANKRUPT:
+        wcout << L"Проигрыш: деньги закончились!" << endl;
+        return EXIT_FAILURE;
+    case DIRECTOR_LOST:
+        wcout << L"Вас изгнали из братства, геге\n";
+        return 0;
+    default:
+        return 0;
+    }
+}
+
+// Экспорт журнала показателей в <prefix>.csv и <prefix>.zmet
+void exportMetrics(const Zoo& zoo, const wstring& prefix) {
+    if (prefix.empty()) return;
+    string path = toUtf8(prefix);
+    bool ok = zoo.getMetrics().exportCsv(path + ".csv") && zoo.getMetrics().exportBinary(path + ".zmet");
+    if (ok) {
+        wcout << L"Показатели сохранены: " << prefix << L".csv, " << prefix << L".zmet\n";
+    }
+    else {
+        wcout << L"Не удалось сохранить показатели в " << prefix << endl;
+    }
+}
+
+// Вывод отчета профилирования (только при сборке с -DZOO_PROFILE)
+void showProfileReport(const Zoo& zoo, bool enabled) {
+#ifdef ZOO_PROFILE
+    if (enabled) zoo.getProfiler().report(wcout);
+#else
+    (void)zoo;
+    (void)enabled;
+#endif
+}
+
+// Завершение игры: итог, экспорт показателей и отчет профилирования
+int finishGame(const Zoo& zoo, const wstring& metricsPrefix, bool profileReport) {
+    int code = showGameResult(zoo);
+    exportMetrics(zoo, metricsPrefix);
+    showProfileReport(zoo, profileReport);
+    return code;
+}
+
+// Поиск стратегии без консольной игры: ход поиска и лучшая стратегия
+int runOptimizer(const PolicyOptimizer& optimizer) {
+    wcout << L"Поиск стратегии: " << optimizer.population << L" кандидатов, " << optimizer.generations
+        << L" поколений, " << optimizer.rollouts << L" прогонов на кандидата, потоков: " << optimizer.threads << endl;
+    auto started = chrono::steady_clock::now();
+    PolicyOptimizer::Candidate best = optimizer.run([](int gen, const PolicyOptimizer::Candidate& c) {
+        wcout << L"Поколение " << gen + 1 << L": лучший итог $" << static_cast<long long>(c.score)
+            << L" (банкротств: " << c.bankruptcies << L")" << endl;
+    });
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - started).count();
+
+    Policy policy = decodePolicy(best.genes);
+    wcout << L"\nЛучшая стратегия (средний итог $" << static_cast<long long>(best.score) << L", "
+        << fixed << setprecision(1) << seconds << L" с):\n";
+    wcout << L"   " << POLICY_PARAMS[0].name << L": " << policy.penCapacity << endl;
+    wcout << L"   " << POLICY_PARAMS[1].name << L": " << policy.foodDays << endl;
+    wcout << L"   " << POLICY_PARAMS[2].name << L": $" << policy.advertising << endl;
+    wcout << setprecision(2);
+    wcout << L"   " << POLICY_PARAMS[3].name << L": " << policy.vetRatio << endl;
+    wcout << L"   " << POLICY_PARAMS[4].name << L": " << policy.cleanerRatio << endl;
+    wcout << L"   " << POLICY_PARAMS[5].name << L": " << policy.feederRatio << endl;
+    wcout << L"   " << POLICY_PARAMS[6].name << L": $" << policy.loanAmount << endl;
+    wcout << L"   " << POLICY_PARAMS[7].name << L": " << policy.loanDays << endl;
+    return 0;
+}
+
+// Перебор сценариев по сетке без консольной игры
+int runSweep(SweepRunner& sweep, const wstring& spec, const wstring& cachePath, const wstring& csvPath) {
+    wstring error;
+    if (!sweep.parse(spec, error)) {
+        wcout << L"Ошибка в сетке: " << error << endl;
+        return 1;
+    }
+    sweep.loadCache(toUtf8(cachePath));
+    wcout << L"Перебор: " << sweep.points() << L" точек по " << sweep.seeds << L" прогонов, потоков: "
+        << sweep.threads << endl;
+    auto started = chrono::steady_clock::now();
+    bool ok = sweep.run(toUtf8(csvPath));
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - started).count();
+    wcout << L"Посчитано прогонов: " << sweep.computed << L", из кэша: " << sweep.reused
+        << L" (" << fixed << setprecision(1) << seconds << L" с)\n";
+    if (!ok) {
+        wcout << L"Не удалось записать " << csvPath << endl;
+        return 1;
+    }
+    wcout << L"Итоги по точкам: " << csvPath << endl;
+    return 0;
+}
+
+// Дифференциальная проверка основного хода против эталонного
+int runDiff(const DifferentialHarness& harness) {
+    wcout << L"Дифференциальная проверка: " << harness.runs << L" сценариев по " << harness.days
+        << L" дней, зерно " << harness.seed << endl;
+    DifferentialHarness::Divergence d;
+    bool ok = harness.run(d, [](int run, int days) {
+        wcout << L"Сценарий " << run + 1 << L": OK (" << days << L" дней)" << endl;
+    });
+    if (ok) {
+        wcout << L"Расхождений нет\n";
+        return 0;
+    }
+    wcout << L"Расхождение в сценарии " << d.run + 1 << L", день " << d.day << L": " << d.field << endl;
+    wcout << L"   эталон:   " << d.expected << endl;
+    wcout << L"   основной: " << d.actual << endl;
+    return 1;
+}
+
+// Прогноз перед кредитом: одинаковые ветки будущего (общие зерна) без
+// кредита и с ним под автопилотом
+void previewLoan(Zoo& zoo, int amount, int days, int threads) {
+    const int branches = 8;
+    int horizon = min(max(days, 10), zoo.getMaxDays() - zoo.getDay());
+    if (horizon <= 0) return;
+    unsigned seed = static_cast<unsigned>(zoo.getDay()) * 7919u + 1;
+
+    Zoo withLoan = zoo.fork();
+    withLoan.takeLoan(amount, days);
+    vector<RolloutResult> options[2] = {
+        exploreFutures(zoo, Policy(), branches, horizon, seed, threads),
+        exploreFutures(withLoan, Policy(), branches, horizon, seed, threads)
+    };
+
+    wcout << L"Прогноз на " << horizon << L" дней (" << branches << L" вариантов под автопилотом):\n";
+    const wchar_t* names[2] = { L"без кредита", L"с кредитом" };
+    for (int k = 0; k < 2; ++k) {
+        double worth = 0.0;
+        int bankrupt = 0;
+        for (const RolloutResult& r : options[k]) {
+            worth += r.netWorth;
+            bankrupt += r.status == BANKRUPT ? 1 : 0;
+        }
+        wcout << L"   " << names[k] << L": капитал в среднем $" << static_cast<long long>(worth / branches)
+            << L", банкротств " << bankrupt << L" из " << branches << endl;
+    }
+}
+
+// Мир из многих зоопарков с общей биржей без консольной игры
+int runWorld(int zooCount, int days, int threads, unsigned seed) {
+    Scenario scenario;
+    scenario.maxDays = days;
+    wcout << L"Мир: " << zooCount << L" зоопарков, " << days << L" дней, потоков: " << threads << endl;
+    auto started = chrono::steady_clock::now();
+    World world(zooCount, seed, scenario, Policy());
+    int reportEvery = max(days / 10, 1);
+    while (world.getDay() < days && world.getRunning() > 0) {
+        world.step(threads);
+        if (world.getDay() % reportEvery == 0 || world.getDay() == days) {
+            const TradeBook& book = world.getBook();
+            wcout << L"День " << world.getDay() << L": работают " << world.getRunning() << L"/" << zooCount
+                << L", сделок " << book.getTrades() << L", оборот $" << static_cast<long long>(book.getVolume())
+                << L", заявок на продажу " << book.getOpenAsks() << endl;
+        }
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - started).count();
+    wcout << L"Готово за " << fixed << setprecision(1) << seconds << L" с\n";
+    return 0;
+}
+
+// Главная функция
+int wmain(int argc, wchar_t* argv[]) {
+#ifdef _WIN32
+    // Настройка консоли для работы с Unicode
+    _setmode(_fileno(stdout), _O_U16TEXT);
+    _setmode(_fileno(stdin), _O_U16TEXT);
+    _setmode(_fileno(stderr), _O_U16TEXT);
+#endif
+
+    zooSeed(static_cast<unsigned>(time(0)));
+
+    // Разбор аргументов командной строки
+    wstring metricsPrefix;
+    bool profileReport = false;
+    int visitorLimit = 0;       // 0 - доход по формуле, иначе агентная модель
+    int threadCount = max(static_cast<int>(thread::hardware_concurrency()), 1);
+    bool optimize = false;      // Поиск стратегии вместо игры
+    PolicyOptimizer optimizer;
+    wstring sweepSpec;          // Сетка перебора сценариев вместо игры
+    wstring sweepCache = L"sweep_cache.txt";
+    wstring sweepOut = L"sweep.csv";
+    SweepRunner sweep;
+    int diffRuns = 0;           // Сценариев дифференциальной проверки вместо игры
+    int worldZoos = 0;          // Зоопарков мира вместо игры
+    int days = 0;               // Дней проверки или мира (0 - по умолчанию)
+    DifferentialHarness harness;
+    for (int i = 1; i < argc; ++i) {
+        wstring arg = argv[i];
+        if (arg == L"--metrics" && i + 1 < argc) {
+            metricsPrefix = argv[++i];
+        }
+        else if (arg == L"--profile") {
+            profileReport = true;
+        }
+        else if (arg == L"--visitors" && i + 1 < argc) {
+            visitorLimit = max(static_cast<int>(wcstol(argv[++i], nullptr, 10)), 0);
+        }
+        else if (arg == L"--threads" && i + 1 < argc) {
+            threadCount = max(static_cast<int>(wcstol(argv[++i], nullptr, 10)), 1);
+        }
+        else if (arg == L"--optimize") {
+            optimize = true;
+        }
+        else if (arg == L"--generations" && i + 1 < argc) {
+            optimizer.generations = max(static_cast<int>(wcstol(argv[++i], nullptr, 10)), 1);
+        }
+        else if (arg == L"--population" && i + 1 < argc) {
+            optimizer.population = max(static_cast<int>(wcstol(argv[++i], nullptr, 10)), 4);
+        }
+        else if (arg == L"--rollouts" && i + 1 < argc) {
+            optimizer.rollouts = max(static_cast<int>(wcstol(argv[++i], nullptr, 10)), 1);
+        }
+        else if (arg == L"--seed" && i + 1 < argc) {
+            optimizer.seed = static_cast<unsigned>(wcstoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == L"--sweep" && i + 1 < argc) {
+            sweepSpec = argv[++i];
+        }
+        else if (arg == L"--seeds" && i + 1 < argc) {
+            sweep.seeds = max(static_cast<int>(wcstol(argv[++i], nullptr, 10)), 1);
+        }
+        else if (arg == L"--cache" && i + 1 < argc) {
+            sweepCache = argv[++i];
+        }
+        else if (arg == L"--sweep-out" && i + 1 < argc) {
+            sweepOut = argv[++i];
+        }
+        else if (arg == L"--diff" && i + 1 < argc) {
+            diffRuns = max(static_cast<int>(wcstol(argv[++i], nullptr, 10)), 0);
+        }
+        else if (arg == L"--days" && i + 1 < argc) {
+            days = max(static_cast<int>(wcstol(argv[++i], nullptr, 10)), 1);
+        }
+        else if (arg == L"--world" && i + 1 < argc) {
+            worldZoos = max(static_cast<int>(wcstol(argv[++i], nullptr, 10)), 0);
+        }
+    }
+
+    if (worldZoos > 0) {
+        return runWorld(worldZoos, days > 0 ? days : 100, threadCount, optimizer.seed);
+    }
+
+    if (diffRuns > 0) {
+        if (days > 0) harness.days = days;
+        harness.runs = diffRuns;
+        harness.seed = optimizer.seed;
+        return runDiff(harness);
+    }
+
+    if (!sweepSpec.empty()) {
+        sweep.threads = threadCount;
+        return runSweep(sweep, sweepSpec, sweepCache, sweepOut);
+    }
+
+    if (optimize) {
+        optimizer.threads = threadCount;
+        return runOptimizer(optimizer);
+    }
+
+#ifndef ZOO_PROFILE
+    if (profileReport) {
+        wcout << L"Профилирование недоступно: соберите программу с -DZOO_PROFILE\n";
+        profileReport = false;
+    }
+#endif
+
+    // Ввод названия зоопарка
+    wstring zooName;
+    wcout << L"Введите название зоопарка: ";
+    getline(wcin, zooName);
+
+    // Ввод имени директора
+    wstring directorName;
+    while (true) {
+        wcout << L"Введите имя директора: ";
+        getline(wcin, directorName);
+        if (!directorName.empty()) break;
+        wcout << L"Имя не может быть пустым!\n";
+    }
+
+    // Создание зоопарка
+    Zoo myZoo(zooName, directorName);
+    if (visitorLimit > 0) myZoo.enableVisitorModel(visitorLimit, threadCount);
+
+    // Экран с перерисовкой только изменившихся строк
+    Screen screen;
+
+    // Главный игровой цикл
+    while (true) {
+        // Информация о зоопарке
+        vector<wstring> frame;
+        frame.push_back(L"=== " + myZoo.getName() + L" ===");
+        frame.push_back(L"Директор: " + directorName);
+        frame.push_back(L"День: " + to_wstring(myZoo.getDay()) + L" из " + to_wstring(myZoo.getMaxDays()));
+        frame.push_back(L"Деньги: $" + to_wstring(static_cast<int>(myZoo.getMoney())));
+        frame.push_back(L"Еда: " + to_wstring(myZoo.getFood(HERBIVORE)) + L" растительной, " + to_wstring(myZoo.getFood(CARNIVORE)) + L" мяса");
+        frame.push_back(L"Популярность: " + to_wstring(myZoo.getPopularity()));
+        frame.push_back(L"Животных: " + to_wstring(myZoo.totalAnimals()));
+
+        if (myZoo.getDebt() > 0) {
+            frame.push_back(L"Кредит: $" + to_wstring(static_cast<int>(myZoo.getDebt())) + L" (осталось дней: " + to_wstring(myZoo.getDebtDaysLeft()) + L")");
+        }
+
+        // Информация о работниках
+        frame.push_back(L"Работники:");
+        const WorkerRoster& roster = myZoo.getWorkers();
+        int vets = roster.count(VET);
+        int cleaners = roster.count(CLEANER);
+        int feeders = roster.count(FEEDER);
+        int directors = roster.count(DIRECTOR);
+        frame.push_back(L"   Ветеринары: " + to_wstring(vets) + L" (рекомендуется: " + to_wstring(myZoo.calculateNeededVets()) + L") ($50/день)");
+        frame.push_back(L"   Уборщики: " + to_wstring(cleaners) + L" (рекомендуется: " + to_wstring(myZoo.calculateNeededCleaners()) + L") ($20/день)");
+        frame.push_back(L"   Кормильщики: " + to_wstring(feeders) + L" (рекомендуется: " + to_wstring(myZoo.calculateNeededFeeders()) + L") ($30/день)");
+        frame.push_back(L"   Директор: " + to_wstring(directors) + L" ($500/день)");
+
+        // Меню действий
+        frame.push_back(L"");
+        frame.push_back(L"Действия:");
+        frame.push_back(L"1. Управление животными");
+        frame.push_back(L"2. Закупки");
+        frame.push_back(L"3. Постройки");
+        frame.push_back(L"4. Следующий день");
+        frame.push_back(L"5. Рынок животных");
+        frame.push_back(L"6. Скрещивание");
+        frame.push_back(L"7. Кредит");
+        frame.push_back(L"8. Лечение");
+        frame.push_back(L"9. Управление работниками");
+        frame.push_back(L"0. Выход");
+        screen.render(frame);
+
+        int choice;
+        while (true) {
+            wcout << L"Выберите действие (0-9): ";
+            if (wcin >> choice && 0 <= choice && choice <= 9) break;
+            wcin.clear();
+            wcin.ignore(numeric_limits<streamsize>::max(), L'\n');
+            wcout << L"Ошибка: введите число от 0 до 9\n";
+        }
+        wcin.ignore();
+
+        if (choice == 0) break;
+
+        // Обработка выбранного действия
+        switch (choice) {
+        case 1: { // Управление животными
+            wcout << L"1. Купить животное с рынка\n"
+                << L"2. Продать животное\n"
+                << L"3. Просмотр животных\n"
+                << L"4. Переименовать животное\n"
+                << L"5. Генетика по видам\n"
+                << L"0. Отмена\n";
+            int sub;
+            while (true) {
+                wcout << L"Выберите действие (0-5): ";
+                if (wcin >> sub && sub >= 0 && sub <= 5) break;
+                wcin.clear();
+                wcin.ignore(numeric_limits<streamsize>::max(), L'\n');
+                wcout << L"Ошибка: введите число от 0 до 5\n";
+            }
+            wcin.ignore();
+
+            if (sub == 0) break;
+
+            if (sub == 1) { // Купить животное
+                if (!myZoo.canBuyAnimal()) {
+                    wcout << L"После 10 дня можно покупать только 1 животное в день\n";
+                    break;
+                }
+
+                if (myZoo.getPens().empty()) {
+                    wcout << L"Нет вольеров для животных\n";
+                    break;
+                }
+
+                wcout << L"\nДоступные животные на рынке:\n";
+                const auto& marketAnimals = myZoo.getMarket().getAnimals();
+                for (size_t i = 0; i < marketAnimals.size(); ++i) {
+                    wcout << (i + 1) << L". " << marketAnimals[i]->getName() << L" ("
+                        << marketAnimals[i]->getSpecies() << L", "
+                        << marketAnimals[i]->getGenderName() << L", "
+                        << marketAnimals[i]->getDescription() << L", $"
+                        << static_cast<int>(myZoo.buyPrice(*marketAnimals[i])) << L")\n";
+                }
+
+                int animalChoice;
+                while (true) {
+                    wcout << L"Животное (1-" << marketAnimals.size() << L", 0 для отмены): ";
+                    if (wcin >> animalChoice && (animalChoice == 0 || (animalChoice >= 1 &&
+                        animalChoice <= static_cast<int>(marketAnimals.size())))) break;
+                    wcin.clear();
+                    wcin.ignore(numeric_limits<streamsize>::max(), L'\n');
+                    wcout << L"Ошибка: введите 0 или номер животного\n";
+                }
+                wcin.ignore();
+
+                if (animalChoice == 0) break;
+
+                Pen* suitablePen = myZoo.findPenFor(marketAnimals[animalChoice - 1]);
+                if (!suitablePen) {
+                    wcout << L"Нет подходящего вольера\n";
+                    break;
+                }
+
+                if (myZoo.buyFromMarket(animalChoice - 1, *suitablePen)) {
+                    wcout << L"Животное куплено!\n";
+                }
+                else {
+                    wcout << L"Не удалось купить животное\n";
+                }
+            }
+            else if (sub == 2) { // Продать животное
+                if (myZoo.getPens().empty()) {
+                    wcout << L"Нет животных для продажи\n";
+                    break;
+                }
+
+                wcout << L"Выберите вольер:\n";
+                for (size_t i = 0; i < myZoo.getPens().size(); ++i) {
+                    wcout << (i + 1) << L". " << myZoo.getPens()[i].getDescription() << L" ("
+                        << myZoo.getPens()[i].getAnimalCount() << L")\n";
+                }
+                int penIndex;
+                while (true) {
+                    wcout << L"Вольер (1-" << myZoo.getPens().size() << L", 0 для отмены): ";
+                    if (wcin >> penIndex && (penIndex == 0 || (penIndex >= 1 &&
+                        penIndex <= static_cast<int>(myZoo.getPens().size())))) break;
+                }
+                wcin.ignore();
+
+                if (penIndex == 0) break;
+
+                Pen& selectedPen = myZoo.getPens()[penIndex - 1];
+                const vector<AnimalPtr>& animals = selectedPen.getAnimals();
+
+                if (animals.empty()) {
+                    wcout << L"Вольер пуст\n";
+                    continue;
+                }
+
+                wcout << L"Выберите животное:\n";
+                int animalIndex = AnimalPager::browse(animals, myZoo.getDay(), ROW_DETAILED, true) + 1;
+
+                if (animalIndex == 0) break;
+
+                double revenue = myZoo.sellAnimal(penIndex - 1, animalIndex - 1);
+                wcout << L"Продано за $" << static_cast<int>(revenue) << endl;
+            }
+            else if (sub == 3) { // Просмотр
+                myZoo.showAllPens();
+            }
+            else if (sub == 4) { // Переименовать
+                if (myZoo.getPens().empty()) {
+                    wcout << L"Нет животных для переименования\n";
+                    break;
+                }
+
+                wcout << L"Выберите вольер:\n";
+                for (size_t i = 0; i < myZoo.getPens().size(); ++i) {
+                    wcout << (i + 1) << L". " << myZoo.getPens()[i].getDescription() << L" ("
+                        << myZoo.getPens()[i].getAnimalCount() << L")\n";
+                }
+                int penIndex;
+                while (true) {
+                    wcout << L"Вольер (1-" << myZoo.getPens().size() << L", 0 для отмены): ";
+                    if (wcin >> penIndex && (penIndex == 0 || (penIndex >= 1 &&
+                        penIndex <= static_cast<int>(myZoo.getPens().size())))) break;
+                    wcin.clear();
+                    wcin.ignore(numeric_limits<streamsize>::max(), L'\n');
+                    wcout << L"Ошибка: введите 0 или корректный номер\n";
+                }
+                wcin.ignore();
+
+                if (penIndex == 0) break;
+
+                Pen& selectedPen = myZoo.getPens()[penIndex - 1];
+                const vector<AnimalPtr>& animals = selectedPen.getAnimals();
+
+                if (animals.empty()) {
+                    wcout << L"Вольер пуст\n";
+                    continue;
+                }
+
+                wcout << L"Выберите животное:\n";
+                int animalIndex = AnimalPager::browse(animals, myZoo.getDay(), ROW_DETAILED, true) + 1;
+
+                if (animalIndex == 0) break;
+
+                wstring newName;
+                wcout << L"Введите новое имя: ";
+                getline(wcin, newName);
+                myZoo.ownPen(penIndex - 1);
+                animals[animalIndex - 1]->setName(newName);
+                wcout << L"Имя изменено!\n";
+                myZoo.addEvent(L"Переименовано животное: " + newName);
+            }
+            else if (sub == 5) { // Генетика
+                myZoo.getGenetics().showReport();
+            }
+            break;
+        }
+        case 2: { // Закупки
+            wcout << L"1. Купить еду\n"
+                << L"2. Реклама\n"
+                << L"0. Отмена\n";
+            int sub;
+            while (true) {
+                wcout << L"Действие (0-2): ";
+                if (wcin >> sub && sub >= 0 && sub <= 2) break;
+                wcin.clear();
+                wcin.ignore(numeric_limits<streamsize>::max(), L'\n');
+                wcout << L"Ошибка: введите 0, 1 или 2\n";
+            }
+            wcin.ignore();
+
+            if (sub == 0) break;
+
+            if (sub == 1) { // Купить еду
+                wcout << L"1. " << FOOD_TYPES[HERBIVORE] << L" (хранится " << FoodStock::shelfLife(HERBIVORE) << L" дн.)\n"
+                    << L"2. " << FOOD_TYPES[CARNIVORE] << L" (хранится " << FoodStock::shelfLife(CARNIVORE) << L" дн.)\n"
+                    << L"0. Отмена\n";
+                int dietChoice;
+                while (true) {
+                    wcout << L"Вид корма (0-2): ";
+                    if (wcin >> dietChoice && dietChoice >= 0 && dietChoice <= 2) break;
+                    wcin.clear();
+                    wcin.ignore(numeric_limits<streamsize>::max(), L'\n');
+                    wcout << L"Ошибка: введите 0, 1 или 2\n";
+                }
+                wcin.ignore();
+
+                if (dietChoice == 0) break;
+
+                AnimalType diet = (dietChoice == 1) ? HERBIVORE : CARNIVORE;
+                int amount;
+                while (true) {
+                    wcout << L"Сколько еды купить? (1 еда = $1, 0 для отмены): ";
+                    if (wcin >> amount && (amount == 0 || amount > 0)) break;
+                    wcin.clear();
+                    wcin.ignore(numeric_limits<streamsize>::max(), L'\n');
+                    wcout << L"Ошибка: введите 0 или положительное число\n";
+                }
+                wcin.ignore();
+
+                if (amount == 0) break;
+
+                if (!myZoo.buyFood(diet, amount)) {
+                    wcout << L"Недостаточно средств\n";
+                }
+            }
+            else if (sub == 2) { // Реклама
+                int cost;
+                while (true) {
+                    wcout << L"Сколько потратить? (1$ = +1 популярность, 0 для отмены): ";
+                    if (wcin >> cost && (cost == 0 || cost > 0)) break;
+                    wcin.clear();
+                    wcin.ignore(numeric_limits<streamsize>::max(), L'\n');
+                    wcout << L"Ошибка: введите 0 или положительное число\n";
+                }
+                wcin.ignore();
+
+                if (cost == 0) break;
+
+                if (!myZoo.advertise(cost)) {
+                    wcout << L"Недостаточно средств\n";
+                }
+            }
+            break;
+        }
+        case 3: { // Постройки
+            wcout << L"1. Построить вольер\n"
+                << L"2. Просмотр вольеров\n"
+                << L"3. Уничтожить вольер\n"
+                << L"4. Соединить/разъединить соседние вольеры\n"
+                << L"0. Отмена\n";
+            int sub;
+            while (true) {
+                wcout << L"Действие (0-4): ";
+                if (wcin >> sub && sub >= 0 && sub <= 4) break;
+                wcin.clear();
+                wcin.ignore(numeric_limits<streamsize>::max(), L'\n');
+                wcout << L"Ошибка: введите число от 0 до 4\n";
+            }
+            wcin.ignore();
+
+            if (sub == 0) break;
+
+            if (sub == 1) { // Построить вольер
+                wcout << L"1. Травоядные\n"
+                    << L"2. Хищники\n"
+                    << L"0. Отмена\nТип: ";
+                int type;
+                while (true) {
+                    if (wcin >> type && (type == 0 || type == 1 || type == 2)) break;
+                    wcin.clear();
+                    wcin.ignore(numeric_limits<streamsize>::max(), L'\n');
+                    wcout << L"Ошибка: введите 0, 1 или 2\n";
+                }
+                wcin.ignore();
+
+                if (type == 0) break;
+
+                AnimalType at = (type == 1) ? HERBIVORE : CARNIVORE;
+
+                wcout << L"\nКлимат:\n";
+                for (size_t i = 0; i < CLIMATES.size(); ++i) {
+                    wcout << (i + 1) << L". " << CLIMATES[i] << endl;
+                }
+                int climateChoice;
+                while (true) {
+                    wcout << L"Климат (1-" << CLIMATES.size() << L", 0 для отмены): ";
+                    if (wcin >> climateChoice && (climateChoice == 0 || (climateChoice >= 1 && climateChoice <= static_cast<int>(CLIMATES.size())))) break;
+                    wcin.clear();
+                    wcin.ignore(numeric_limits<streamsize>::max(), L'\n');
+                    wcout << L"Ошибка: введите 0 или число от 1 до " << CLIMATES.size() << endl;
+                }
+                wcin.ignore();
+
+                if (climateChoice == 0) break;
+
+                Climate cl = static_cast<Climate>(climateChoice - 1);
+
+                int cap;
+                while (true) {
+                    wcout << L"Вместимость (1-100, 0 для отмены): ";
+                    if (wcin >> cap && (cap == 0 || (cap >= 1 && cap <= 100))) break;
+                    wcin.clear();
+                    wcin.ignore(numeric_limits<streamsize>::max(), L'\n');
+                    wcout << L"Ошибка: введите 0 или число от 1 до 100\n";
+                }
+                wcin.ignore();
+
+                if (cap == 0) break;
+
+                if (myZoo.buildPen(cap, at, cl)) {
+                    wcout << L"Вольер построен за $" << cap * 10 << L"!\n";
+                }
+                else {
+                    wcout << L"Недостаточно средств\n";
+                }
+            }
+            else if (sub == 2) { // Просмотр вольеров
+                myZoo.showAllPens();
+            }
+            else if (sub == 3) { // Уничтожить вольер
+                if (myZoo.getPens().empty()) {
+                    wcout << L"Нет вольеров для уничтожения\n";
+                    break;
+                }
+
+                wcout << L"Выберите вольер для уничтожения:\n";
+                for (size_t i = 0; i < myZoo.getPens().size(); ++i) {
+                    wcout << (i + 1) << L". " << myZoo.getPens()[i].getDescription() << L" ("
+                        << myZoo.getPens()[i].getAnimalCount() << L" животных)\n";
+                }
+
+                int penIndex;
+                while (true) {
+                    wcout << L"Вольер (1-" << myZoo.getPens().size() << L", 0 для отмены): ";
+                    if (wcin >> penIndex) {
+                        if (penIndex == 0 || (penIndex >= 1 && penIndex <= static_cast<int>(myZoo.getPens().size()))) break;
+                    }
+                    wcin.clear();
+                    wcin.ignore(numeric_limits<streamsize>::max(), L'\n');
+                    wcout << L"Ошибка: введите 0 или номер вольера\n";
+                }
+                wcin.ignore();
+
+                if (penIndex == 0) break;
+
+                myZoo.destroyPen(penIndex - 1);
+            }
+            else if (sub == 4) { // Соседство вольеров
+                if (myZoo.getPens().size() < 2) {
+                    wcout << L"Нужно хотя бы два вольера\n";
+                    break;
+                }
+
+                wcout << L"Вольеры:\n";
+                for (size_t i = 0; i < myZoo.getPens().size(); ++i) {
+                    wcout << (i + 1) << L". " << myZoo.getPens()[i].getDescription() << endl;
+                }
+
+                int firstIndex;
+                int secondIndex;
+                while (true) {
+                    wcout << L"Два вольера через пробел (0 для отмены): ";
+                    if (wcin >> firstIndex) {
+                        if (firstIndex == 0) break;
+                        if (wcin >> secondIndex &&
+                            firstIndex >= 1 && firstIndex <= static_cast<int>(myZoo.getPens().size()) &&
+                            secondIndex >= 1 && secondIndex <= static_cast<int>(myZoo.getPens().size()) &&
+                            firstIndex != secondIndex) break;
+                    }
+                    wcin.clear();
+                    wcin.ignore(numeric_limits<streamsize>::max(), L'\n');
+                    wcout << L"Ошибка: введите два разных номера вольеров\n";
+                }
+                wcin.ignore();
+
+                if (firstIndex == 0) break;
+
+                if (myZoo.togglePenLink(firstIndex - 1, secondIndex - 1)) {
+                    wcout << L"Вольеры стали соседями: болезнь может переходить между ними\n";
+                }
+                else {
+                    wcout << L"Вольеры больше не соседи\n";
+                }
+            }
+            break;
+        }
+        case 4: // Следующий день
+            if (myZoo.nextDay() != RUNNING) {
+                return finishGame(myZoo, metricsPrefix, profileReport);
+            }
+            break;
+        case 5: { // Рынок животных
+            wcout << L"1. Просмотр рынка животных\n"
+                << L"2. Обновить рынок животных ($200)\n"
+                << L"0. Отмена\n";
+            int sub;
+            while (true) {
+                wcout << L"Действие (0-2): ";
+                if (wcin >> sub && sub >= 0 && sub <= 2) break;
+                wcin.clear();
+                wcin.ignore(numeric_limits<streamsize>::max(), L'\n');
+                wcout << L"Ошибка: введите 0, 1 или 2\n";
+            }
+            wcin.ignore();
+
+            if (sub == 0) break;
+
+            if (sub == 1) { // Просмотр рынка животных
+                wcout << L"\nДоступные животные на рынке:\n";
+                const auto& marketAnimals = myZoo.getMarket().getAnimals();
+                for (size_t i = 0; i < marketAnimals.size(); ++i) {
+                    wcout << (i + 1) << L". " << marketAnimals[i]->getName() << L" ("
+                        << marketAnimals[i]->getSpecies() << L", "
+                        << marketAnimals[i]->getGenderName() << L", "
+                        << marketAnimals[i]->getDescription() << L", $"
+                        << static_cast<int>(myZoo.buyPrice(*marketAnimals[i])) << L")\n";
+                }
+            }
+            else if (sub == 2) { // Обновить рынок животных
+                double money = myZoo.getMoney();
+                if (myZoo.getMarket().update(myZoo.getDay(), money)) {
+                    myZoo.setMoney(money);
+                    wcout << L"Рынок животных обновлен!\n";
+                    myZoo.addEvent(L"Рынок животных обновлен");
+                }
+                else {
+                    wcout << L"Не удалось обновить рынок (недостаточно средств или еще не время)\n";
+                }
+            }
+            break;
+        }
+        case 6: { // Скрещивание
+            myZoo.manualBreeding();
+            break;
+        }
+        case 7: { // Кредит
+            if (myZoo.getDebt() > 0) {
+                wcout << L"У вас уже есть непогашенный кредит\n";
+                break;
+            }
+
+            int amount;
+            int days;
+            wcout << L"Сумма кредита: ";
+            wcin >> amount;
+            wcout << L"Срок (дни): ";
+            wcin >> days;
+            if (amount > 0 && days > 0) {
+                previewLoan(myZoo, amount, days, threadCount);
+                int confirm;
+                wcout << L"Взять кредит? (1 - да, 0 - нет): ";
+                if (wcin >> confirm && confirm == 1) {
+                    myZoo.takeLoan(amount, days);
+                }
+                wcin.clear();
+                wcin.ignore(numeric_limits<streamsize>::max(), L'\n');
+            }
+            break;
+        }
+        case 8: { // Лечение
+            wcout << L"1. Лечить животное ($100)\n"
+                << L"2. Лечить всех животных\n"
+                << L"0. Отмена\n";
+            int sub;
+            while (true) {
+                wcout << L"Действие (0-2): ";
+                if (wcin >> sub && sub >= 0 && sub <= 2) break;
+                wcin.clear();
+                wcin.ignore(numeric_limits<streamsize>::max(), L'\n');
+                wcout << L"Ошибка: введите 0, 1 или 2\n";
+            }
+            wcin.ignore();
+
+            if (sub == 0) break;
+
+            if (sub == 1) { // Лечить животное
+                myZoo.treatAnimal();
+            }
+            else if (sub == 2) { // Лечить всех животных
+                myZoo.treatAllAnimals();
+            }
+            break;
+        }
+        case 9: { // Управление работниками
+            wcout << L"1. Нанять работника\n"
+                << L"2. Переименовать работника\n"
+                << L"3. Уволить работника\n"
+                << L"4. Порядок уборки вольеров\n"
+                << L"0. Отмена\n";
+            int sub;
+            while (true) {
+                wcout << L"Выберите действие (0-4): ";
+                if (wcin >> sub && sub >= 0 && sub <= 4) break;
+                wcin.clear();
+                wcin.ignore(numeric_limits<streamsize>::max(), L'\n');
+                wcout << L"Ошибка: введите число от 0 до 4\n";
+            }
+            wcin.ignore();
+
+            if (sub == 0) break;
+
+            if (sub == 1) { // Нанять работника
+                myZoo.hireWorker();
+            }
+            else if (sub == 2) { // Переименовать работника
+                myZoo.renameWorker();
+            }
+            else if (sub == 3) { // Уволить работника
+                if (myZoo.getWorkers().empty()) {
+                    wcout << L"Нет работников для увольнения\n";
+                    break;
+                }
+
+                wcout << L"Выберите работника для увольнения:\n";
+                for (size_t i = 0; i < myZoo.getWorkers().size(); ++i) {
+                    wcout << (i + 1) << L". " << myZoo.getWorkers()[i].name << L" ("
+                        << myZoo.getWorkers()[i].getTypeName() << L")\n";
+                }
+
+                int workerIndex;
+                while (true) {
+                    wcout << L"Работник (1-" << myZoo.getWorkers().size() << L", 0 для отмены): ";
+                    if (wcin >> workerIndex) {
+                        if (workerIndex == 0 || (workerIndex >= 1 && workerIndex <= static_cast<int>(myZoo.getWorkers().size()))) break;
+                    }
+                    wcin.clear();
+                    wcin.ignore(numeric_limits<streamsize>::max(), L'\n');
+                    wcout << L"Ошибка: введите 0 или номер работника\n";
+                }
+                wcin.ignore();
+
+                if (workerIndex == 0) break;
+
+                myZoo.removeWorker(workerIndex - 1);
+                wcout << L"Работник уволен!\n";
+                if (myZoo.isOver()) {
+                    return finishGame(myZoo, metricsPrefix, profileReport);
+                }
+            }
+            else if (sub == 4) { // Порядок уборки
+                wcout << L"Текущий порядок: " << CLEANING_PRIORITY_NAMES[myZoo.getCleaningPriority()] << endl;
+                for (size_t i = 0; i < CLEANING_PRIORITY_NAMES.size(); ++i) {
+                    wcout << (i + 1) << L". " << CLEANING_PRIORITY_NAMES[i] << endl;
+                }
+                int priorityChoice;
+                while (true) {
+                    wcout << L"Порядок (1-" << CLEANING_PRIORITY_NAMES.size() << L", 0 для отмены): ";
+                    if (wcin >> priorityChoice && priorityChoice >= 0 && priorityChoice <= static_cast<int>(CLEANING_PRIORITY_NAMES.size())) break;
+                    wcin.clear();
+                    wcin.ignore(numeric_limits<streamsize>::max(), L'\n');
+                    wcout << L"Ошибка: введите 0 или номер порядка\n";
+                }
+                wcin.ignore();
+
+                if (priorityChoice == 0) break;
+
+                myZoo.setCleaningPriority(static_cast<CleaningPriority>(priorityChoice - 1));
+                wcout << L"Порядок уборки изменен\n";
+            }
+            break;
+        }
+        }
+
+        waitForEnter();
+    }
+
+    exportMetrics(myZoo, metricsPrefix);
+    showProfileReport(myZoo, profileReport);
+    return 0;
+}
+
+#ifndef _WIN32
+// Точка входа вне Windows: настройка локали и преобразование аргументов для wmain
+int main(int argc, char* argv[]) {
+    const char* loc = setlocale(LC_ALL, "");
+    if (!loc || (!strstr(loc, "UTF-8") && !strstr(loc, "utf8"))) {
+        setlocale(LC_ALL, "C.UTF-8");
+    }
+
+    vector<wstring> args;
+    for (int i = 0; i < argc; ++i) {
+        size_t len = mbstowcs(nullptr, argv[i], 0);
+        wstring arg(len == static_cast<size_t>(-1) ? 0 : len, L'\0');
+        if (!arg.empty()) mbstowcs(&arg[0], argv[i], len);
+        args.push_back(arg);
+    }
+    vector<wchar_t*> wargv;
+    for (auto& arg : args) wargv.push_back(&arg[0]);
+    wargv.push_back(nullptr);
+
+    return wmain(argc, wargv.data());
+}
+#endif
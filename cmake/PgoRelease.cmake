@@ -0,0 +1,106 @@
+# Релизная сборка с LTO и PGO и замер против обычной сборки -O2.
+# Запускается целью pgo_release или напрямую:
+#   cmake -DSOURCE_DIR=. -DWORK_DIR=build/release -P cmake/PgoRelease.cmake
+#
+# 1. WORK_DIR/o2  - обычная сборка -O2 (как в README), точка отсчета.
+# 2. WORK_DIR/pgo - сборка с LTO и сбором профиля, обучающий прогон нагрузки
+#    zoo_bench --train, пересборка в том же каталоге по профилю.
+# 3. Замер zoo_bench в обеих сборках на одних и тех же зернах.
+
+if(NOT SOURCE_DIR OR NOT WORK_DIR)
+    message(FATAL_ERROR "Нужны -DSOURCE_DIR=... и -DWORK_DIR=...")
+endif()
+
+# Обучающая нагрузка идет на других зернах, чем замер
+set(TRAIN_ARGS --train --runs 6 --days 300 --seed 1000)
+set(BENCH_ARGS --runs 4 --days 300 --seed 1 --repeat 5)
+
+set(exe_suffix "")
+if(CMAKE_HOST_WIN32)
+    set(exe_suffix ".exe")
+endif()
+
+function(run_step)
+    execute_process(COMMAND ${ARGN} RESULT_VARIABLE rc)
+    if(NOT rc EQUAL 0)
+        message(FATAL_ERROR "Команда завершилась с ошибкой: ${ARGN}")
+    endif()
+endfunction()
+
+function(configure dir)
+    set(args -S ${SOURCE_DIR} -B ${dir} -DCMAKE_BUILD_TYPE=Release)
+    if(GENERATOR)
+        list(APPEND args -G ${GENERATOR})
+    endif()
+    if(CXX_COMPILER)
+        list(APPEND args -DCMAKE_CXX_COMPILER=${CXX_COMPILER})
+    endif()
+    run_step(${CMAKE_COMMAND} ${args} ${ARGN})
+endfunction()
+
+function(build dir)
+    run_step(${CMAKE_COMMAND} --build ${dir} --config Release ${ARGN})
+endfunction()
+
+# Замер: медиана времени и контрольная сумма состояния
+function(bench dir out_ms out_sum)
+    execute_process(COMMAND ${dir}/zoo_bench${exe_suffix} ${BENCH_ARGS}
+        RESULT_VARIABLE rc OUTPUT_VARIABLE output)
+    if(NOT rc EQUAL 0 OR NOT output MATCHES "median_ms=([0-9]+).*checksum=([0-9.-]+)")
+        message(FATAL_ERROR "Замер в ${dir} не удался: ${output}")
+    endif()
+    message(STATUS "${dir}: ${output}")
+    set(${out_ms} ${CMAKE_MATCH_1} PARENT_SCOPE)
+    set(${out_sum} ${CMAKE_MATCH_2} PARENT_SCOPE)
+endfunction()
+
+set(o2_dir ${WORK_DIR}/o2)
+set(pgo_dir ${WORK_DIR}/pgo)
+set(profile_dir ${pgo_dir}/pgo-data)
+
+message(STATUS "Сборка -O2")
+configure(${o2_dir} "-DCMAKE_CXX_FLAGS_RELEASE=-O2 -DNDEBUG" -DZOO_LTO=OFF -DZOO_PGO=)
+build(${o2_dir} --target zoo_bench)
+
+message(STATUS "Сборка LTO со сбором профиля")
+file(REMOVE_RECURSE ${profile_dir})
+configure(${pgo_dir} -DZOO_LTO=ON -DZOO_PGO=GENERATE -DZOO_PGO_DIR=${profile_dir})
+build(${pgo_dir} --target zoo_bench)
+
+message(STATUS "Обучающий прогон")
+run_step(${pgo_dir}/zoo_bench${exe_suffix} ${TRAIN_ARGS})
+
+# Clang пишет сырые профили, их нужно слить в один
+file(GLOB raw_profiles ${profile_dir}/*.profraw)
+if(raw_profiles)
+    find_program(LLVM_PROFDATA NAMES llvm-profdata)
+    if(NOT LLVM_PROFDATA)
+        message(FATAL_ERROR "Для Clang нужен llvm-profdata")
+    endif()
+    run_step(${LLVM_PROFDATA} merge -output=${profile_dir}/zoo.profdata ${raw_profiles})
+endif()
+
+message(STATUS "Сборка LTO по профилю")
+configure(${pgo_dir} -DZOO_LTO=ON -DZOO_PGO=USE -DZOO_PGO_DIR=${profile_dir})
+build(${pgo_dir})
+
+message(STATUS "Замер")
+bench(${o2_dir} o2_ms o2_sum)
+bench(${pgo_dir} pgo_ms pgo_sum)
+if(NOT o2_sum STREQUAL pgo_sum)
+    message(WARNING "Контрольные суммы сборок различаются: ${o2_sum} и ${pgo_sum}")
+endif()
+if(pgo_ms EQUAL 0)
+    set(pgo_ms 1)
+endif()
+math(EXPR ratio "${o2_ms} * 1000 / ${pgo_ms}")
+math(EXPR ratio_int "${ratio} / 1000")
+math(EXPR ratio_frac "${ratio} % 1000")
+string(LENGTH "${ratio_frac}" frac_len)
+if(frac_len EQUAL 1)
+    set(ratio_frac "00${ratio_frac}")
+elseif(frac_len EQUAL 2)
+    set(ratio_frac "0${ratio_frac}")
+endif()
+message(STATUS "-O2: ${o2_ms} мс, LTO+PGO: ${pgo_ms} мс, ускорение ${ratio_int}.${ratio_frac}x")
+message(STATUS "Релизная сборка: ${pgo_dir}/zoo_simulator${exe_suffix}")
@@ -0,0 +1,178 @@
+// Животные: реестр видов, родословная и генетика
+#include "animal.h"
+
+SpeciesInfo& SpeciesRegistry::add(const wstring& name, bool hybrid, int parentA, int parentB, double minWeight, double maxWeight) {
+    entries.push_back(SpeciesInfo{ static_cast<int>(entries.size()), name, name, hybrid,
+        parentA, parentB, minWeight, maxWeight });
+    byName.emplace(name, entries.back().id);
+    return entries.back();
+}
+
+const SpeciesInfo& SpeciesRegistry::intern(const wstring& name, double minWeight, double maxWeight) {
+    lock_guard<mutex> guard(lock);
+    auto it = byName.find(name);
+    if (it != byName.end()) return entries[it->second];
+    return add(name, false, -1, -1, minWeight, maxWeight);
+}
+
+const SpeciesInfo& SpeciesRegistry::hybridOf(const SpeciesInfo& a, const SpeciesInfo& b) {
+    if (a.id == b.id) return a;
+    const SpeciesInfo& first = a.name < b.name ? a : b;
+    const SpeciesInfo& second = a.name < b.name ? b : a;
+
+    lock_guard<mutex> guard(lock);
+    auto it = hybrids.find(make_pair(first.id, second.id));
+    if (it != hybrids.end()) return entries[it->second];
+
+    wstring name = first.name.substr(0, first.name.size() / 2 + 1) + second.name.substr(second.name.size() / 2);
+    auto existing = byName.find(name);
+    SpeciesInfo* info;
+    if (existing != byName.end()) {
+        info = &entries[existing->second];
+    }
+    else {
+        info = &add(name, true, first.id, second.id,
+            (first.minWeight + second.minWeight) / 2.0, (first.maxWeight + second.maxWeight) / 2.0);
+        info->description = L"Гибрид " + first.name + L" и " + second.name;
+    }
+    hybrids.emplace(make_pair(first.id, second.id), info->id);
+    return *info;
+}
+
+void Animal::initialize() {
+    // Генерация случайного веса в пределах min-max
+    weight = min_weight + static_cast<double>(zooRand() % static_cast<int>((max_weight - min_weight) * 100)) / 100.0;
+    pedigreeId = nextPedigreeId();
+    // Основатель родословной получает случайные аллели
+    for (int l = 0; l < GENE_LOCI; ++l) {
+        genome.alleles[l][0] = static_cast<uint8_t>(zooRand() % ALLELES_PER_LOCUS);
+        genome.alleles[l][1] = static_cast<uint8_t>(zooRand() % ALLELES_PER_LOCUS);
+    }
+}
+
+double Animal::kinship(const Animal* a, const Animal* b) {
+    if (!a || !b) return 0.0;
+    // Копии одного животного (ветки, рынок) различаются указателем, но не номером
+    if (a == b || a->pedigreeId == b->pedigreeId) return 0.5 * (1.0 + a->inbreeding);
+    if (a->pedigreeId < b->pedigreeId) swap(a, b);
+    // Основатель не родственен никому из более старших животных
+    if (!a->parent1 && !a->parent2) return 0.0;
+
+    KinshipKey key(a->pedigreeId, b->pedigreeId);
+    unordered_map<KinshipKey, double, KinshipKeyHash>& cache = kinshipCache();
+    auto it = cache.find(key);
+    if (it != cache.end()) return it->second;
+
+    double value = 0.5 * (kinship(a->parent1.get(), b) + kinship(a->parent2.get(), b));
+    // Кэш ограничен по памяти: при переполнении начинается заново
+    if (cache.size() >= (1u << 22)) cache.clear();
+    cache.emplace(key, value);
+    return value;
+}
+
+bool Animal::canDieOfOldAge(int maxAge, int today) const {
+    int age = getAgeDays(today);
+    if (age > maxAge) {
+        int chance = age - maxAge;
+        return zooRand() % 100 < chance;
+    }
+    return false;
+}
+
+AnimalPtr Animal::breed(const AnimalPtr& a1, const AnimalPtr& a2, int today) {
+    // Проверка возможности размножения
+    if (!a1->canReproduce(today) || !a2->canReproduce(today)) {
+        wcout << L"Ошибка: одно из животных не может размножаться (слишком молодо, больно или умирает)\n";
+        return nullptr;
+    }
+
+    // Проверка разных полов
+    if (a1->gender == a2->gender) {
+        wcout << L"Ошибка: нельзя скрещивать животных одного пола\n";
+        return nullptr;
+    }
+
+    // Вид потомка: тот же вид или гибрид пары из реестра (имя и признаки
+    // гибрида вычисляются один раз на пару видов)
+    bool hybrid = a1->species != a2->species;
+    const SpeciesInfo& newSpecies = hybrid ?
+        SpeciesRegistry::instance().hybridOf(*a1->species, *a2->species) : *a1->species;
+    Climate newClimate = a1->climate;
+    if (hybrid) {
+        newClimate = (zooRand() % 2 == 0) ? a1->climate : a2->climate;
+    }
+
+    // Определение характеристик потомства
+    AnimalType newType = (zooRand() % 2 == 0) ? a1->type : a2->type;
+    Gender newGender = (zooRand() % 2 == 0) ? MALE : FEMALE;
+
+    double newPrice = (a1->price + a2->price) / 2.0 * (hybrid ? 0.8 : 1.0);
+
+    // Создание нового животного
+    AnimalPtr child = make_shared<Animal>(newSpecies, newType, newClimate, newPrice, newGender, a1, a2, hybrid);
+
+    // Наследование: от каждого родителя случайный аллель в каждом локусе
+    child->birthDay = today;
+    child->generation = max(a1->generation, a2->generation) + 1;
+    child->inbreeding = kinship(a1.get(), a2.get());
+    for (int l = 0; l < GENE_LOCI; ++l) {
+        child->genome.alleles[l][0] = a1->genome.alleles[l][zooRand() % 2];
+        child->genome.alleles[l][1] = a2->genome.alleles[l][zooRand() % 2];
+    }
+    return child;
+}
+
+bool Animal::operator==(const Animal& other) const {
+    return name == other.name &&
+        type == other.type &&
+        climate == other.climate &&
+        price == other.price &&
+        description == other.description &&
+        isInfected == other.isInfected &&
+        isDying == other.isDying &&
+        birthDay == other.birthDay &&
+        infectionDay == other.infectionDay &&
+        weight == other.weight &&
+        min_weight == other.min_weight &&
+        max_weight == other.max_weight &&
+        gender == other.gender &&
+        species == other.species;
+}
+
+void PopulationGenetics::record(const Animal& a) {
+    vector<GenerationStats>& generations = bySpecies[a.getSpeciesId()];
+    if (static_cast<int>(generations.size()) <= a.getGeneration()) {
+        generations.resize(a.getGeneration() + 1);
+    }
+    GenerationStats& stats = generations[a.getGeneration()];
+    stats.count++;
+    stats.inbreedingSum += a.getInbreeding();
+    stats.weightSum += a.getWeight();
+    const Genome& g = a.getGenome();
+    for (int l = 0; l < GENE_LOCI; ++l) {
+        stats.alleleCounts[l][g.alleles[l][0]]++;
+        stats.alleleCounts[l][g.alleles[l][1]]++;
+    }
+}
+
+void PopulationGenetics::showReport(int lastGenerations) const {
+    if (bySpecies.empty()) {
+        wcout << L"Нет данных: в зоопарке еще не было животных\n";
+        return;
+    }
+    for (const auto& entry : bySpecies) {
+        const vector<GenerationStats>& generations = entry.second;
+        wcout << L"\n" << SpeciesRegistry::instance().get(entry.first).name << L":\n";
+        int first = max(0, static_cast<int>(generations.size()) - lastGenerations);
+        for (int g = first; g < static_cast<int>(generations.size()); ++g) {
+            const GenerationStats& stats = generations[g];
+            if (stats.count == 0) continue;
+            wcout << L"   поколение " << g << L": " << stats.count << L" жив., инбридинг "
+                << fixed << setprecision(3) << stats.meanInbreeding() << L", гетерозиготность "
+                << stats.heterozygosity() << L", средний вес " << setprecision(1) << stats.meanWeight()
+                << L" кг" << endl;
+            wcout.unsetf(ios::fixed);
+            wcout << setprecision(6);
+        }
+    }
+}
@@ -0,0 +1,252 @@
+// Животные: реестр видов, родословная и генетика
+#pragma once
+
+#include "common.h"
+
+// Предварительное объявление класса Animal
+class Animal;
+using AnimalPtr = shared_ptr<Animal>;
+
+// Генотип: GENE_LOCI нейтральных локусов по два аллеля (от каждого родителя)
+const int GENE_LOCI = 8;
+const int ALLELES_PER_LOCUS = 8;
+
+struct Genome {
+    uint8_t alleles[GENE_LOCI][2];
+};
+
+// Сведения о виде. Имя, описание и диапазон веса гибрида вычисляются один
+// раз при первом скрещивании пары видов
+struct SpeciesInfo {
+    int id;                 // Номер вида
+    wstring name;           // Каноническое название
+    wstring description;    // Описание потомства ("Гибрид A и B" или название)
+    bool hybrid;            // Гибридный вид
+    int parentA;            // Родительские виды гибрида (-1 у обычного вида)
+    int parentB;
+    double minWeight;       // Диапазон веса вида
+    double maxWeight;
+};
+
+// Реестр видов, общий для всех зоопарков процесса. Виды получают целые
+// номера, гибрид пары видов создается один раз и дальше берется из кэша.
+// Записи не удаляются и не перемещаются (deque), поэтому животные хранят
+// указатель на запись и читают ее без блокировки
+class SpeciesRegistry {
+private:
+    deque<SpeciesInfo> entries;             // Виды по номерам
+    map<wstring, int> byName;               // Название -> номер
+    map<pair<int, int>, int> hybrids;       // Пара видов (меньший номер первым) -> гибрид
+    mutable mutex lock;
+
+    SpeciesRegistry() {}
+
+    SpeciesInfo& add(const wstring& name, bool hybrid, int parentA, int parentB, double minWeight, double maxWeight);
+
+public:
+    static SpeciesRegistry& instance() {
+        static SpeciesRegistry registry;
+        return registry;
+    }
+
+    // Номер вида по названию (диапазон веса запоминается при первой регистрации)
+    const SpeciesInfo& intern(const wstring& name, double minWeight, double maxWeight);
+
+    // Гибрид двух видов: название из начала первого по алфавиту вида и конца
+    // второго (номера видов зависят от порядка регистрации в потоках, а
+    // название не должно), диапазон веса - среднее диапазонов родительских видов
+    const SpeciesInfo& hybridOf(const SpeciesInfo& a, const SpeciesInfo& b);
+
+    const SpeciesInfo& get(int id) const {
+        lock_guard<mutex> guard(lock);
+        return entries[id];
+    }
+
+    size_t size() const {
+        lock_guard<mutex> guard(lock);
+        return entries.size();
+    }
+};
+
+// Класс, представляющий животное
+class Animal {
+private:
+    wstring name;           // Имя животного
+    AnimalType type;        // Тип (травоядное/хищник)
+    Climate climate;        // Климатическая зона
+    double price;           // Цена животного
+    wstring description;    // Описание
+    bool isInfected = false; // Заражено ли животное
+    bool isDying = false;   // Умирает ли животное
+    int birthDay = 0;       // День зоопарка, в который животному 1 день (возраст не хранится,
+                            // поэтому смена дня не трогает животных)
+    int infectionDay = 0;   // День заражения
+    double weight;          // Вес животного
+    double min_weight;      // Минимальный вес для вида
+    double max_weight;      // Максимальный вес для вида
+    Gender gender;          // Пол животного
+    AnimalPtr parent1 = nullptr; // Первый родитель
+    AnimalPtr parent2 = nullptr; // Второй родитель
+    const SpeciesInfo* species; // Вид животного (запись реестра видов)
+    bool isHybrid = false;  // Является ли гибридом
+    uint64_t pedigreeId;    // Номер в родословной (родители всегда старше потомка)
+    int generation = 0;     // Поколение (0 - животное с рынка)
+    double inbreeding = 0.0; // Коэффициент инбридинга F
+    Genome genome;          // Генотип
+
+    // Сквозная нумерация животных для родословной. Счетчик общий для всех
+    // потоков и 64-битный: 32-битный счетчик в долгих прогонах оптимизатора
+    // мог переполниться, и потомок получил бы номер меньше родительского
+    static uint64_t nextPedigreeId() {
+        static atomic<uint64_t> counter(0);
+        return counter++;
+    }
+
+    // Ключ кэша родства: пара номеров (младший, старший)
+    typedef pair<uint64_t, uint64_t> KinshipKey;
+    struct KinshipKeyHash {
+        size_t operator()(const KinshipKey& k) const {
+            return hash<uint64_t>()(k.first * 0x9E3779B97F4A7C15ull ^ k.second);
+        }
+    };
+
+    // Кэш коэффициентов родства по паре номеров (свой в каждом потоке:
+    // родословная неизменна, поэтому кэш можно не синхронизировать)
+    static unordered_map<KinshipKey, double, KinshipKeyHash>& kinshipCache() {
+        static thread_local unordered_map<KinshipKey, double, KinshipKeyHash> cache;
+        return cache;
+    }
+
+    friend class ReferenceTick;
+
+public:
+    // Конструктор животного
+    Animal(wstring n, AnimalType t, Climate c, double p, wstring desc, double min_w, double max_w, Gender g, wstring sp,
+        AnimalPtr p1 = nullptr, AnimalPtr p2 = nullptr, bool hybrid = false)
+        : name(n), type(t), climate(c), price(p), description(desc),
+        min_weight(min_w), max_weight(max_w), gender(g),
+        species(&SpeciesRegistry::instance().intern(sp, min_w, max_w)),
+        parent1(p1), parent2(p2), isHybrid(hybrid) {
+        initialize();
+    }
+
+    // Конструктор потомка: вид, описание и диапазон веса берутся из реестра
+    Animal(const SpeciesInfo& sp, AnimalType t, Climate c, double p, Gender g,
+        AnimalPtr p1, AnimalPtr p2, bool hybrid)
+        : name(sp.name), type(t), climate(c), price(p), description(sp.description),
+        min_weight(sp.minWeight), max_weight(sp.maxWeight), gender(g), species(&sp),
+        parent1(p1), parent2(p2), isHybrid(hybrid) {
+        initialize();
+    }
+
+private:
+    void initialize();
+
+public:
+
+    // Геттеры для всех полей
+    const wstring& getName() const { return name; }
+    AnimalType getType() const { return type; }
+    Climate getClimate() const { return climate; }
+    double getPrice() const { return price; }
+    const wstring& getDescription() const { return description; }
+    bool getIsInfected() const { return isInfected; }
+    bool getIsDying() const { return isDying; }
+    int getBirthDay() const { return birthDay; }
+    // Возраст в днях на день today
+    int getAgeDays(int today) const { return today - birthDay + 1; }
+    int getInfectionDay() const { return infectionDay; }
+    double getWeight() const { return weight; }
+    Gender getGender() const { return gender; }
+    const wstring& getGenderName() const { return GENDER_NAMES[static_cast<int>(gender)]; }
+    const wstring& getSpecies() const { return species->name; }
+    int getSpeciesId() const { return species->id; }
+    const SpeciesInfo& getSpeciesInfo() const { return *species; }
+    const AnimalPtr& getParent1() const { return parent1; }
+    const AnimalPtr& getParent2() const { return parent2; }
+    bool getIsHybrid() const { return isHybrid; }
+    uint64_t getPedigreeId() const { return pedigreeId; }
+    int getGeneration() const { return generation; }
+    double getInbreeding() const { return inbreeding; }
+    const Genome& getGenome() const { return genome; }
+
+    // Коэффициент родства: вероятность, что случайные аллели двух животных
+    // происходят от одного предка. Рекурсия идет от младшего к его родителям,
+    // результат запоминается по паре номеров, поэтому каждая пара предков
+    // считается один раз, а не при каждом пути в родословной
+    static double kinship(const Animal* a, const Animal* b);
+
+    // Сеттеры
+    void setName(const wstring& newName) { name = newName; }
+    void setInfected(bool infected, int day) { isInfected = infected; infectionDay = day; }
+    void setDying(bool dying) { isDying = dying; }
+    void setBirthDay(int day) { birthDay = day; }
+
+    // Проверка, может ли животное размножаться в день today
+    bool canReproduce(int today) const {
+        return getAgeDays(today) >= 5 && !isInfected && !isDying;
+    }
+
+    // Проверка, может ли животное умереть от старости в день today
+    bool canDieOfOldAge(int maxAge, int today) const;
+
+    // Попытка побега (в текущей реализации всегда false)
+    bool tryEscape() const {
+        return false;
+    }
+
+    // Размножение двух животных (потомок рождается в день today)
+    static AnimalPtr breed(const AnimalPtr& a1, const AnimalPtr& a2, int today);
+
+    // Оператор сравнения животных
+    bool operator==(const Animal& other) const;
+};
+
+// Учет генетики по видам и поколениям. Пополняется при каждом появлении
+// животного в зоопарке (покупка или рождение), поэтому отчет не обходит
+// родословную и не зависит от ее глубины
+class PopulationGenetics {
+public:
+    // Сводка одного поколения вида
+    struct GenerationStats {
+        int count = 0;              // Животных в поколении
+        double inbreedingSum = 0.0; // Сумма коэффициентов инбридинга
+        double weightSum = 0.0;     // Сумма весов (наследуемый признак)
+        int alleleCounts[GENE_LOCI][ALLELES_PER_LOCUS] = {}; // Частоты аллелей
+
+        double meanInbreeding() const { return count ? inbreedingSum / count : 0.0; }
+        double meanWeight() const { return count ? weightSum / count : 0.0; }
+
+        // Доля аллеля в локусе
+        double frequency(int locus, int allele) const {
+            return count ? static_cast<double>(alleleCounts[locus][allele]) / (2 * count) : 0.0;
+        }
+
+        // Ожидаемая гетерозиготность 1 - сумма p^2, средняя по локусам
+        double heterozygosity() const {
+            if (count == 0) return 0.0;
+            double total = 0.0;
+            for (int l = 0; l < GENE_LOCI; ++l) {
+                double homozygous = 0.0;
+                for (int a = 0; a < ALLELES_PER_LOCUS; ++a) {
+                    double p = frequency(l, a);
+                    homozygous += p * p;
+                }
+                total += 1.0 - homozygous;
+            }
+            return total / GENE_LOCI;
+        }
+    };
+
+private:
+    map<int, vector<GenerationStats>> bySpecies; // Номер вида -> поколения
+
+public:
+    // Учет нового животного
+    void record(const Animal& a);
+
+    const map<int, vector<GenerationStats>>& getSpecies() const { return bySpecies; }
+
+    // Отчет по видам: последние поколения каждого вида
+    void showReport(int lastGenerations = 10) const;
+};
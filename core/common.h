@@ -0,0 +1,115 @@
+// Общие определения ядра: стандартные заголовки, генератор случайных чисел,
+// вывод и перечисления игры
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <cmath>
+#include <ctime>
+#include <algorithm>
+#include <locale>
+#include <limits>
+#include <ios>
+#include <map>
+#include <set>
+#include <sstream>
+#include <memory>
+#include <climits>
+#include <fstream>
+#include <cstdint>
+#include <chrono>
+#include <iomanip>
+#include <queue>
+#include <deque>
+#include <unordered_set>
+#include <unordered_map>
+#include <tuple>
+#include <random>
+#include <functional>
+#include <clocale>
+#include <cstring>
+#include <stdexcept>
+#include <cerrno>
+#include <cwchar>
+#include <cwctype>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <io.h>
+#include <fcntl.h>
+#else
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// Генератор случайных чисел игры. Свой у каждого потока, поэтому несколько
+// зоопарков могут ходить параллельно, и каждый прогон воспроизводим по зерну
+inline mt19937& zooEngine() {
+    static thread_local mt19937 engine(5489u);
+    return engine;
+}
+
+// Случайное число 0..2^31-1 (замена rand())
+inline int zooRand() {
+    return static_cast<int>(zooEngine()() >> 1);
+}
+
+// Установка зерна генератора текущего потока (замена srand())
+inline void zooSeed(unsigned seed) {
+    zooEngine().seed(seed);
+}
+
+// Тихий режим вывода текущего потока (фоновые прогоны без консоли)
+inline bool& zooQuiet() {
+    static thread_local bool quiet = false;
+    return quiet;
+}
+
+// Поток для сообщений хода: wcout или пустой поток в тихом режиме
+inline wostream& zooOut() {
+    static thread_local wostream nullStream(nullptr);
+    return zooQuiet() ? nullStream : wcout;
+}
+
+// Перечисление типов животных
+enum AnimalType { HERBIVORE, CARNIVORE };
+// Перечисление климатических зон
+enum Climate { TROPICAL, TEMPERATE, ARCTIC, DESERT };
+// Перечисление типов работников
+enum WorkerType { VET, CLEANER, FEEDER, DIRECTOR };
+// Перечисление полов животных
+enum Gender { MALE, FEMALE };
+// Состояние игры после хода
+enum GameStatus { RUNNING, VICTORY, BANKRUPT, DIRECTOR_LOST };
+// Причины гибели животных
+enum DeathCause { DEATH_DISEASE, DEATH_OLD_AGE, DEATH_STARVATION };
+
+// Названия климатических зон
+const vector<wstring> CLIMATES = {
+    L"Тропический",
+    L"Умеренный",
+    L"Арктический",
+    L"Пустынный"
+};
+
+// Названия полов
+const vector<wstring> GENDER_NAMES = {
+    L"Самец",
+    L"Самка"
+};
+
+// Названия типов работников
+const vector<wstring> WORKER_TYPES = {
+    L"Ветеринар",
+    L"Уборщик",
+    L"Кормильщик",
+    L"Директор"
+};
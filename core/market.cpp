@@ -0,0 +1,184 @@
+// Рынок животных и склад корма
+#include "market.h"
+
+namespace {
+
+// Виды, которые продаются на рынке
+struct MarketSpecies {
+    const wchar_t* name;
+    double price;
+    double minWeight;
+    double maxWeight;
+    AnimalType type;
+    Climate climate;
+};
+
+const MarketSpecies MARKET_SPECIES[] = {
+    { L"Лев", 1000.0, 180.0, 250.0, CARNIVORE, TROPICAL },
+    { L"Тигр", 950.0, 160.0, 230.0, CARNIVORE, TEMPERATE },
+    { L"Жираф", 700.0, 800.0, 1200.0, HERBIVORE, TROPICAL },
+    { L"Слон", 800.0, 5000.0, 6000.0, HERBIVORE, TEMPERATE },
+    { L"Зебра", 600.0, 250.0, 400.0, HERBIVORE, DESERT },
+    { L"Волк", 700.0, 40.0, 80.0, CARNIVORE, ARCTIC },
+    { L"Гепард", 850.0, 35.0, 65.0, CARNIVORE, DESERT },
+    { L"Овцебык", 750.0, 200.0, 400.0, HERBIVORE, ARCTIC }
+};
+
+const int MARKET_SPECIES_COUNT = sizeof(MARKET_SPECIES) / sizeof(MARKET_SPECIES[0]);
+
+} // namespace
+
+void AnimalMarket::open(unsigned marketSeed) {
+    seed = marketSeed;
+    // Виды рынка регистрируются сразу: номера видов не должны зависеть от того,
+    // в каком потоке рынок впервые покажет животных
+    for (const MarketSpecies& sp : MARKET_SPECIES) {
+        SpeciesRegistry::instance().intern(sp.name, sp.minWeight, sp.maxWeight);
+    }
+    restock(0, 0, 0);
+}
+
+void AnimalMarket::materialize() const {
+    animals.clear();
+    // Генератор выпуска зависит только от зерна рынка, дня и номера выпуска
+    seed_seq issueSeed = { seed, static_cast<unsigned>(stockDay), static_cast<unsigned>(stockIssue) };
+    mt19937 saved = zooEngine();
+    zooEngine() = mt19937(issueSeed);
+
+    for (int i = 0; i < MAX_ANIMALS; ++i) {
+        const MarketSpecies& sp = MARKET_SPECIES[zooRand() % MARKET_SPECIES_COUNT];
+        Gender gender = zooRand() % 2 == 0 ? MALE : FEMALE;
+        wstring desc = (sp.climate == TROPICAL ? L"Тропический" :
+            sp.climate == ARCTIC ? L"Арктический" :
+            sp.climate == DESERT ? L"Пустынный" : L"Умеренный");
+
+        // Создание нового животного
+        animals.push_back(make_shared<Animal>(
+            sp.name, sp.type, sp.climate, sp.price, desc,
+            sp.minWeight, sp.maxWeight, gender, sp.name
+        ));
+        animals.back()->setBirthDay(saleDay);
+    }
+
+    zooEngine() = saved;
+    stocked = true;
+}
+
+bool AnimalMarket::update(int currentDay, double& money) {
+    if (canUpdate(currentDay)) {
+        if (money >= UPDATE_COST) {
+            money -= UPDATE_COST;
+            restock(currentDay, 1, currentDay);
+            return true;
+        }
+    }
+    return false;
+}
+
+AnimalPtr AnimalMarket::buyAnimal(int index, double price, int currentDay, double& money) {
+    if (!stocked) materialize();
+    if (index >= 0 && index < animals.size()) {
+        if (money >= price) {
+            money -= price;
+            AnimalPtr bought = animals[index];
+            animals.erase(animals.begin() + index);
+            prices.recordBuy(bought->getSpeciesId(), currentDay);
+            return bought;
+        }
+    }
+    return nullptr;
+}
+
+void PriceBoard::Window::advance(int day) {
+    if (day <= head) return;
+    if (head < 0 || day - head >= WINDOW_DAYS) {
+        for (Bucket& b : buckets) b = Bucket();
+        buys = 0;
+        sells = 0;
+    }
+    else {
+        for (int d = head + 1; d <= day; ++d) {
+            Bucket& b = buckets[d % WINDOW_DAYS];
+            buys -= b.buys;
+            sells -= b.sells;
+            b = Bucket();
+        }
+    }
+    head = day;
+}
+
+PriceBoard::Window& PriceBoard::windowAt(int speciesId, int day) const {
+    if (speciesId >= static_cast<int>(windows.size())) windows.resize(speciesId + 1);
+    Window& w = windows[speciesId];
+    w.advance(day);
+    return w;
+}
+
+double PriceBoard::ask(const Animal& a, int population, int maxAge, int day) const {
+    const Window& w = windowAt(a.getSpeciesId(), day);
+    double traded = w.buys + w.sells;
+
+    // Спрос: перевес покупок поднимает цену, перевес продаж опускает
+    double demand = 1.0 + DEMAND_WEIGHT * (w.buys - w.sells) / (traded + MARKET_DEPTH);
+
+    // Редкость: от +20% для невиданного вида до -20% для очень многочисленного
+    double scarcity = 0.8 + 0.4 * SCARCITY_REF / (max(population, 0) + SCARCITY_REF);
+
+    // Гибрид ценится, пока им мало торгуют
+    double rarity = a.getIsHybrid() ? 1.0 + HYBRID_PREMIUM * MARKET_DEPTH / (traded + MARKET_DEPTH) : 1.0;
+
+    // Возраст: со второй половины жизни цена падает вдвое к предельному возрасту
+    double life = maxAge > 0 ? min(static_cast<double>(a.getAgeDays(day)) / maxAge, 1.0) : 0.0;
+    double age = life <= 0.5 ? 1.0 : 1.5 - life;
+
+    // Вес: от -10% у самых легких до +10% у самых тяжелых животных вида
+    const SpeciesInfo& sp = a.getSpeciesInfo();
+    double span = sp.maxWeight - sp.minWeight;
+    double position = span > 0 ? min(max((a.getWeight() - sp.minWeight) / span, 0.0), 1.0) : 0.5;
+    double weight = 0.9 + 0.2 * position;
+
+    return a.getPrice() * demand * scarcity * rarity * age * weight;
+}
+
+void FoodStock::add(AnimalType diet, int amount, int currentDay) {
+    if (amount <= 0) return;
+    FoodLot lot = { amount, currentDay + shelfLife(diet) };
+    lots[diet].push_back(lot);
+    totals[diet] += amount;
+}
+
+int FoodStock::removeExpired(int currentDay) {
+    int spoiled = 0;
+    for (int diet = 0; diet < 2; ++diet) {
+        while (!lots[diet].empty() && lots[diet].front().expiryDay <= currentDay) {
+            spoiled += lots[diet].front().amount;
+            totals[diet] -= lots[diet].front().amount;
+            lots[diet].pop_front();
+        }
+    }
+    return spoiled;
+}
+
+int FoodStock::fresh(AnimalType diet, int currentDay) const {
+    // Сроки партий одного вида растут в порядке закупки
+    int expired = 0;
+    for (const FoodLot& lot : lots[diet]) {
+        if (lot.expiryDay > currentDay) break;
+        expired += lot.amount;
+    }
+    return totals[diet] - expired;
+}
+
+int FoodStock::consume(AnimalType diet, int amount) {
+    int given = 0;
+    while (amount > 0 && !lots[diet].empty()) {
+        FoodLot& lot = lots[diet].front();
+        int take = min(amount, lot.amount);
+        lot.amount -= take;
+        amount -= take;
+        given += take;
+        if (lot.amount == 0) lots[diet].pop_front();
+    }
+    totals[diet] -= given;
+    return given;
+}
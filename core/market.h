@@ -0,0 +1,184 @@
+// Рынок животных и склад корма
+#pragma once
+
+#include "animal.h"
+
+// Рыночные цены. Цена животного - его базовая цена с поправками на спрос
+// (перевес покупок над продажами вида за последние WINDOW_DAYS дней),
+// редкость вида, гибридность, возраст и вес. Сделки учитываются в кольце
+// дневных корзин каждого вида вместе с текущими суммами окна: запись сделки
+// и запрос цены стоят O(1), устаревшие корзины вычитаются при сдвиге окна
+class PriceBoard {
+public:
+    static const int WINDOW_DAYS = 14; // Окно учета сделок в днях
+
+    // Учет сделок с рынком
+    void recordBuy(int speciesId, int day) { windowAt(speciesId, day).add(day, 1, 0); }
+    void recordSell(int speciesId, int day) { windowAt(speciesId, day).add(day, 0, 1); }
+
+    // Цена покупки животного у рынка; population - сколько животных вида
+    // видно покупателю (в его вольерах и на рынке), maxAge - предел возраста
+    double ask(const Animal& a, int population, int maxAge, int day) const;
+
+    // Цена, по которой рынок покупает животное
+    double bid(const Animal& a, int population, int maxAge, int day) const {
+        return ask(a, population, maxAge, day) * SELL_SHARE;
+    }
+
+    // Сделки вида за окно, заканчивающееся днем day
+    int getBuys(int speciesId, int day) const { return windowAt(speciesId, day).buys; }
+    int getSells(int speciesId, int day) const { return windowAt(speciesId, day).sells; }
+
+private:
+    const double SELL_SHARE = 0.85;     // Доля цены, которую платит рынок при продаже
+    const double DEMAND_WEIGHT = 0.5;   // Наибольшая поправка на спрос
+    const double MARKET_DEPTH = 4.0;    // Сделок, при которых спрос сдвигает цену вдвое слабее
+    const double SCARCITY_REF = 5.0;    // Численность вида, при которой поправки на редкость нет
+    const double HYBRID_PREMIUM = 0.5;  // Надбавка за гибрид, которым еще не торговали
+
+    struct Bucket {
+        int buys = 0;
+        int sells = 0;
+    };
+
+    // Окно вида: корзина дня d лежит в buckets[d % WINDOW_DAYS]
+    struct Window {
+        Bucket buckets[WINDOW_DAYS];
+        int head = -1;              // Последний день, до которого сдвинуто окно
+        int buys = 0;               // Суммы по корзинам окна
+        int sells = 0;
+
+        // Сдвиг окна к дню day (не дальше WINDOW_DAYS корзин)
+        void advance(int day);
+
+        void add(int day, int buyCount, int sellCount) {
+            Bucket& b = buckets[day % WINDOW_DAYS];
+            b.buys += buyCount;
+            b.sells += sellCount;
+            buys += buyCount;
+            sells += sellCount;
+        }
+    };
+
+    // Окна по номерам видов; сдвигаются лениво, в том числе при запросе цены
+    mutable vector<Window> windows;
+
+    Window& windowAt(int speciesId, int day) const;
+};
+
+// Класс, представляющий рынок животных. Ассортимент не создается заранее:
+// рынок помнит только, какой выпуск сейчас на прилавке (день и номер
+// выпуска), а животные создаются из зерна рынка при первом обращении.
+// Содержимое выпуска определяется зерном и не зависит от того, когда и
+// сколько раз к рынку обращались, поэтому прогоны без игрока не тратят
+// время на рынки, в которые никто не заглядывает
+class AnimalMarket {
+private:
+    unsigned seed = 0;          // Зерно рынка
+    int stockDay = 0;           // День текущего выпуска
+    int stockIssue = 0;         // Номер выпуска: 0 - ночной, 1 - платное обновление
+    int saleDay = 0;            // День продажи выпуска (животным выпуска в этот день 1 день)
+    mutable bool stocked = false; // Выпуск уже создан
+    mutable vector<AnimalPtr> animals; // Доступные животные (после создания выпуска)
+    PriceBoard prices;          // Цены с учетом сделок
+    int lastUpdateDay = -1;     // Последний день обновления
+    const int MAX_ANIMALS = 10; // Максимальное количество животных
+    const int UPDATE_COST = 200; // Стоимость обновления
+
+    // Выставление нового выпуска, который продается с дня onSale
+    // (животные создадутся при обращении)
+    void restock(int currentDay, int issue, int onSale) {
+        stockDay = currentDay;
+        stockIssue = issue;
+        saleDay = onSale;
+        stocked = false;
+        animals.clear();
+        lastUpdateDay = currentDay;
+    }
+
+    // Создание животных выпуска на собственном генераторе рынка
+    void materialize() const;
+
+public:
+    // Зерно рынка и первый выпуск (день 0)
+    void open(unsigned marketSeed);
+
+    // Ночная смена ассортимента к следующему дню. Если сегодня рынок уже
+    // обновляли за деньги, этот выпуск остается и на завтра, а его животные
+    // по-прежнему считаются родившимися в день продажи
+    void nextIssue(int currentDay) {
+        if (canUpdate(currentDay)) {
+            restock(currentDay, 0, currentDay + 1);
+            return;
+        }
+        saleDay = currentDay + 1;
+        for (AnimalPtr& a : animals) a->setBirthDay(saleDay);
+    }
+
+    // Проверка возможности обновления рынка
+    bool canUpdate(int currentDay) const {
+        return currentDay > lastUpdateDay;
+    }
+
+    // Обновление рынка животных
+    bool update(int currentDay, double& money);
+
+    // Геттеры (первое обращение к выпуску создает его животных)
+    const vector<AnimalPtr>& getAnimals() const {
+        if (!stocked) materialize();
+        return animals;
+    }
+    PriceBoard& getPrices() { return prices; }
+    const PriceBoard& getPrices() const { return prices; }
+
+    // Собственные копии уже созданных животных выпуска (для ветки зоопарка)
+    void detach() {
+        for (AnimalPtr& a : animals) a = make_shared<Animal>(*a);
+    }
+
+    // Покупка животного с рынка по цене price (сделка учитывается в ценах)
+    AnimalPtr buyAnimal(int index, double price, int currentDay, double& money);
+};
+
+// Названия видов корма (по типу животных)
+const vector<wstring> FOOD_TYPES = {
+    L"Растительный корм",
+    L"Мясо"
+};
+
+// Партия корма
+struct FoodLot {
+    int amount;                 // Оставшееся количество
+    int expiryDay;              // День, с которого партия испорчена
+};
+
+// Склад корма: партии каждого вида хранятся в порядке закупки (FIFO),
+// расходуются и портятся с самой старой партии
+class FoodStock {
+private:
+    deque<FoodLot> lots[2];     // Партии по видам корма (HERBIVORE, CARNIVORE)
+    int totals[2] = { 0, 0 };   // Общее количество по видам
+
+public:
+    // Срок хранения в днях: мясо портится быстрее
+    static int shelfLife(AnimalType diet) {
+        return diet == CARNIVORE ? 5 : 14;
+    }
+
+    // Поступление новой партии
+    void add(AnimalType diet, int amount, int currentDay);
+
+    // Списание испорченных партий, возвращает списанное количество
+    int removeExpired(int currentDay);
+
+    // Расход корма с самых старых партий, возвращает выданное количество
+    int consume(AnimalType diet, int amount);
+
+    // Корм вида, еще не испорченный к дню currentDay (склад не меняется)
+    int fresh(AnimalType diet, int currentDay) const;
+
+    // Геттеры
+    int total(AnimalType diet) const { return totals[diet]; }
+    int total() const { return totals[HERBIVORE] + totals[CARNIVORE]; }
+    const deque<FoodLot>& getLots(AnimalType diet) const { return lots[diet]; }
+};
@@ -0,0 +1,209 @@
+// Ежедневные показатели зоопарка
+#include "metrics.h"
+#include "animal.h"
+
+void MetricsRecorder::writeLittleEndian(ofstream& out, uint64_t value, int bytes) {
+    char buffer[8];
+    for (int i = 0; i < bytes; ++i) {
+        buffer[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+    out.write(buffer, bytes);
+}
+
+void MetricsRecorder::writeColumn(ofstream& out, const string& name, const vector<int>& col) {
+    writeLittleEndian(out, static_cast<uint16_t>(name.size()), 2);
+    out.write(name.data(), static_cast<uint16_t>(name.size()));
+    writeLittleEndian(out, 0, 1);
+    for (int v : col) {
+        writeLittleEndian(out, static_cast<uint32_t>(static_cast<int32_t>(v)), 4);
+    }
+}
+
+void MetricsRecorder::writeColumn(ofstream& out, const string& name, const vector<double>& col) {
+    writeLittleEndian(out, static_cast<uint16_t>(name.size()), 2);
+    out.write(name.data(), static_cast<uint16_t>(name.size()));
+    writeLittleEndian(out, 1, 1);
+    for (double v : col) {
+        uint64_t bits;
+        memcpy(&bits, &v, sizeof(bits));
+        writeLittleEndian(out, bits, 8);
+    }
+}
+
+MetricsRecorder::MetricsRecorder(int expectedDays) : capacity(expectedDays) {
+    dayCol.reserve(capacity);
+    moneyCol.reserve(capacity);
+    debtCol.reserve(capacity);
+    foodCol.reserve(capacity);
+    popularityCol.reserve(capacity);
+    animalsCol.reserve(capacity);
+    infectedCol.reserve(capacity);
+    for (auto& col : deathsCol) col.reserve(capacity);
+    visitorIncomeCol.reserve(capacity);
+    salaryCol.reserve(capacity);
+}
+
+vector<pair<wstring, const vector<int>*>> MetricsRecorder::speciesByName() const {
+    vector<pair<wstring, const vector<int>*>> columns;
+    for (size_t c = 0; c < speciesCols.size(); ++c) {
+        columns.push_back(make_pair(SpeciesRegistry::instance().get(speciesIds[c]).name, &speciesCols[c]));
+    }
+    sort(columns.begin(), columns.end());
+    return columns;
+}
+
+void MetricsRecorder::record(const DayMetrics& m, const vector<pair<int, int>>& speciesCounts, const vector<pair<int, int>>& penCounts) {
+    dayCol.push_back(m.day);
+    moneyCol.push_back(m.money);
+    debtCol.push_back(m.debt);
+    foodCol.push_back(m.food);
+    popularityCol.push_back(m.popularity);
+    animalsCol.push_back(m.animals);
+    infectedCol.push_back(m.infected);
+    for (int i = 0; i < 3; ++i) deathsCol[i].push_back(m.deaths[i]);
+    visitorIncomeCol.push_back(m.visitorIncome);
+    salaryCol.push_back(m.salary);
+
+    for (const auto& species : speciesCounts) {
+        int id = species.first;
+        if (id >= static_cast<int>(speciesColumn.size())) speciesColumn.resize(id + 1, -1);
+        if (speciesColumn[id] < 0) {
+            speciesColumn[id] = static_cast<int>(speciesCols.size());
+            speciesIds.push_back(id);
+            speciesCols.emplace_back();
+            prepareColumn(speciesCols.back());
+        }
+    }
+    for (auto& col : speciesCols) col.push_back(0);
+    for (const auto& species : speciesCounts) speciesCols[speciesColumn[species.first]].back() += species.second;
+
+    for (const auto& pen : penCounts) {
+        while (static_cast<int>(penCols.size()) <= pen.first) {
+            penCols.emplace_back();
+            prepareColumn(penCols.back());
+        }
+    }
+    for (auto& col : penCols) col.push_back(0);
+    for (const auto& pen : penCounts) penCols[pen.first].back() = pen.second;
+
+    rows++;
+}
+
+bool MetricsRecorder::exportCsv(const string& path) const {
+    ofstream out(path);
+    if (!out) return false;
+
+    vector<pair<wstring, const vector<int>*>> species = speciesByName();
+    out << "day,money,debt,food,popularity,animals,infected,"
+        "deaths_disease,deaths_old_age,deaths_starvation,visitor_income,salary";
+    for (const auto& entry : species) out << ",species:" << toUtf8(entry.first);
+    for (size_t i = 0; i < penCols.size(); ++i) out << ",pen_" << (i + 1);
+    out << "\n";
+
+    // Деньги легко превышают миллион: точность по умолчанию (6 знаков) их округляет
+    out << setprecision(17);
+    for (int r = 0; r < rows; ++r) {
+        out << dayCol[r] << ',' << moneyCol[r] << ',' << debtCol[r] << ',' << foodCol[r] << ','
+            << popularityCol[r] << ',' << animalsCol[r] << ',' << infectedCol[r] << ','
+            << deathsCol[DEATH_DISEASE][r] << ',' << deathsCol[DEATH_OLD_AGE][r] << ','
+            << deathsCol[DEATH_STARVATION][r] << ',' << visitorIncomeCol[r] << ',' << salaryCol[r];
+        for (const auto& entry : species) out << ',' << (*entry.second)[r];
+        for (const auto& col : penCols) out << ',' << col[r];
+        out << "\n";
+    }
+    return static_cast<bool>(out);
+}
+
+bool MetricsRecorder::exportBinary(const string& path) const {
+    ofstream out(path, ios::binary);
+    if (!out) return false;
+
+    out.write("ZMET", 4);
+    writeLittleEndian(out, 1, 4);
+    writeLittleEndian(out, static_cast<uint32_t>(rows), 4);
+    writeLittleEndian(out, static_cast<uint32_t>(12 + speciesCols.size() + penCols.size()), 4);
+
+    writeColumn(out, "day", dayCol);
+    writeColumn(out, "money", moneyCol);
+    writeColumn(out, "debt", debtCol);
+    writeColumn(out, "food", foodCol);
+    writeColumn(out, "popularity", popularityCol);
+    writeColumn(out, "animals", animalsCol);
+    writeColumn(out, "infected", infectedCol);
+    writeColumn(out, "deaths_disease", deathsCol[DEATH_DISEASE]);
+    writeColumn(out, "deaths_old_age", deathsCol[DEATH_OLD_AGE]);
+    writeColumn(out, "deaths_starvation", deathsCol[DEATH_STARVATION]);
+    writeColumn(out, "visitor_income", visitorIncomeCol);
+    writeColumn(out, "salary", salaryCol);
+    for (const auto& entry : speciesByName()) writeColumn(out, "species:" + toUtf8(entry.first), *entry.second);
+    for (size_t i = 0; i < penCols.size(); ++i) writeColumn(out, "pen_" + to_string(i + 1), penCols[i]);
+    return static_cast<bool>(out);
+}
+
+string toUtf8(const wstring& text) {
+    string out;
+    out.reserve(text.size() * 2);
+    for (size_t i = 0; i < text.size(); ++i) {
+        uint32_t cp = static_cast<uint32_t>(text[i]);
+        // Суррогатные пары UTF-16 (wchar_t в Windows)
+        if (cp >= 0xD800 && cp <= 0xDBFF && i + 1 < text.size()) {
+            uint32_t low = static_cast<uint32_t>(text[i + 1]);
+            if (low >= 0xDC00 && low <= 0xDFFF) {
+                cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                ++i;
+            }
+        }
+        if (cp < 0x80) {
+            out += static_cast<char>(cp);
+        }
+        else if (cp < 0x800) {
+            out += static_cast<char>(0xC0 | (cp >> 6));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        }
+        else if (cp < 0x10000) {
+            out += static_cast<char>(0xE0 | (cp >> 12));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        }
+        else {
+            out += static_cast<char>(0xF0 | (cp >> 18));
+            out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        }
+    }
+    return out;
+}
+
+wstring fromUtf8(const string& text) {
+    wstring out;
+    out.reserve(text.size());
+    size_t i = 0;
+    while (i < text.size()) {
+        uint32_t c = static_cast<unsigned char>(text[i]);
+        int extra = c < 0x80 ? 0 : (c >> 5) == 0x6 ? 1 : (c >> 4) == 0xE ? 2 : (c >> 3) == 0x1E ? 3 : -1;
+        uint32_t cp = extra == 0 ? c : extra == 1 ? (c & 0x1F) : extra == 2 ? (c & 0x0F) : (c & 0x07);
+        bool valid = extra >= 0 && i + extra < text.size();
+        for (int k = 1; valid && k <= extra; ++k) {
+            uint32_t next = static_cast<unsigned char>(text[i + k]);
+            if ((next & 0xC0) != 0x80) valid = false;
+            cp = (cp << 6) | (next & 0x3F);
+        }
+        if (!valid) {
+            out += static_cast<wchar_t>(0xFFFD);
+            ++i;
+            continue;
+        }
+        i += extra + 1;
+        // Суррогатные пары UTF-16 (wchar_t в Windows)
+        if (cp >= 0x10000 && sizeof(wchar_t) == 2) {
+            cp -= 0x10000;
+            out += static_cast<wchar_t>(0xD800 + (cp >> 10));
+            out += static_cast<wchar_t>(0xDC00 + (cp & 0x3FF));
+        }
+        else {
+            out += static_cast<wchar_t>(cp);
+        }
+    }
+    return out;
+}
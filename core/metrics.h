@@ -0,0 +1,91 @@
+// Ежедневные показатели зоопарка
+#pragma once
+
+#include "common.h"
+
+// Преобразование строки в UTF-8 (для экспорта в файлы)
+string toUtf8(const wstring& text);
+
+// Преобразование из UTF-8 (неверные последовательности заменяются на U+FFFD)
+wstring fromUtf8(const string& text);
+
+// Показатели одного дня
+struct DayMetrics {
+    int day = 0;                // День
+    double money = 0.0;         // Деньги на конец дня
+    double debt = 0.0;          // Долг
+    int food = 0;               // Запас еды
+    int popularity = 0;         // Популярность
+    int animals = 0;            // Всего животных
+    int infected = 0;           // Зараженных животных
+    int deaths[3] = { 0, 0, 0 }; // Погибшие по причинам (DeathCause)
+    double visitorIncome = 0.0; // Доход от посетителей
+    double salary = 0.0;        // Выплаченная зарплата
+};
+
+// Класс, записывающий ежедневные показатели зоопарка по столбцам
+class MetricsRecorder {
+private:
+    int rows = 0;               // Количество записанных дней
+    int capacity;               // Ожидаемое количество дней (под него выделяется память)
+    vector<int> dayCol;
+    vector<double> moneyCol;
+    vector<double> debtCol;
+    vector<int> foodCol;
+    vector<int> popularityCol;
+    vector<int> animalsCol;
+    vector<int> infectedCol;
+    vector<int> deathsCol[3];
+    vector<double> visitorIncomeCol;
+    vector<double> salaryCol;
+    vector<vector<int>> speciesCols;       // Животных по видам (в порядке появления вида)
+    vector<int> speciesIds;                // Номер вида каждого столбца
+    vector<int> speciesColumn;             // Номер вида -> столбец (-1 - вида еще не было)
+    vector<vector<int>> penCols;           // Животных по вольерам (по постоянному номеру вольера)
+
+    // Новый столбец заполняется нулями за уже записанные дни
+    void prepareColumn(vector<int>& col) const {
+        col.reserve(capacity);
+        col.resize(rows, 0);
+    }
+
+    // Запись чисел в двоичный файл в порядке little-endian (независимо от платформы)
+    static void writeLittleEndian(ofstream& out, uint64_t value, int bytes);
+
+    // Запись целочисленного столбца в двоичный файл
+    static void writeColumn(ofstream& out, const string& name, const vector<int>& col);
+
+    // Запись вещественного столбца в двоичный файл
+    static void writeColumn(ofstream& out, const string& name, const vector<double>& col);
+
+    // Столбцы видов, упорядоченные по названию вида (название, столбец)
+    vector<pair<wstring, const vector<int>*>> speciesByName() const;
+
+public:
+    // Конструктор (память под столбцы выделяется заранее)
+    explicit MetricsRecorder(int expectedDays);
+
+    // Запись показателей дня; speciesCounts - пары (номер вида, животных),
+    // penCounts - пары (номер вольера Pen::getId, животных).
+    // Столбец вольера идет по его постоянному номеру: снос одного вольера не
+    // сдвигает историю остальных, а снесенный вольер дальше пишет нули
+    void record(const DayMetrics& m, const vector<pair<int, int>>& speciesCounts, const vector<pair<int, int>>& penCounts);
+
+    // Геттеры
+    int getRowCount() const { return rows; }
+    const vector<int>& getDays() const { return dayCol; }
+    const vector<double>& getDebt() const { return debtCol; }
+    const vector<int>& getInfected() const { return infectedCol; }
+    const vector<double>& getMoney() const { return moneyCol; }
+    const vector<int>& getPopularity() const { return popularityCol; }
+    const vector<int>& getAnimals() const { return animalsCol; }
+
+    // Экспорт в CSV (столбцы видов по алфавиту)
+    bool exportCsv(const string& path) const;
+
+    // Экспорт в компактный двоичный столбцовый формат:
+    // "ZMET", версия, число строк, число столбцов, затем для каждого столбца
+    // имя (длина + UTF-8), тип (0 - int32, 1 - float64) и все значения подряд.
+    // Все числа записываются в порядке little-endian на любой платформе
+    bool exportBinary(const string& path) const;
+};
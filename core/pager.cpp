@@ -0,0 +1,126 @@
+// Постраничные списки животных
+#include "pager.h"
+
+int AnimalPager::parseNumber(const wstring& line) {
+    const wchar_t* begin = line.c_str();
+    wchar_t* end = nullptr;
+    errno = 0;
+    long value = wcstol(begin, &end, 10);
+    if (end == begin || errno == ERANGE || value < 0 || value > INT_MAX) return -1;
+    while (iswspace(*end)) ++end;
+    if (*end != L'\0') return -1;
+    return static_cast<int>(value);
+}
+
+vector<int> AnimalPager::selectRows(const vector<AnimalPtr>& animals, const AnimalQuery& query) {
+    vector<int> rows;
+    rows.reserve(animals.size());
+    for (size_t i = 0; i < animals.size(); ++i) {
+        const Animal& a = *animals[i];
+        if (query.search.empty() ||
+            a.getName().find(query.search) != wstring::npos ||
+            a.getSpecies().find(query.search) != wstring::npos) {
+            rows.push_back(static_cast<int>(i));
+        }
+    }
+
+    switch (query.sort) {
+    case SORT_AGE:
+        stable_sort(rows.begin(), rows.end(), [&animals](int x, int y) {
+            return animals[x]->getBirthDay() < animals[y]->getBirthDay();
+        });
+        break;
+    case SORT_INFECTION:
+        stable_sort(rows.begin(), rows.end(), [&animals](int x, int y) {
+            return animals[x]->getIsInfected() > animals[y]->getIsInfected();
+        });
+        break;
+    case SORT_SPECIES:
+        stable_sort(rows.begin(), rows.end(), [&animals](int x, int y) {
+            return animals[x]->getSpecies() < animals[y]->getSpecies();
+        });
+        break;
+    default:
+        break;
+    }
+    return rows;
+}
+
+void AnimalPager::printRow(int number, const Animal& a, int today, AnimalRowStyle style) {
+    wcout << number << L". " << a.getName() << L" (" << a.getSpecies();
+    if (style == ROW_FULL && a.getIsHybrid()) {
+        if (a.getParent1()->getSpeciesId() == a.getParent2()->getSpeciesId()) {
+            wcout << L" [гибрид]";
+        }
+        else {
+            wcout << L" [гибрид " << a.getParent1()->getSpecies() << L" и " << a.getParent2()->getSpecies() << L"]";
+        }
+    }
+    wcout << L", " << a.getGenderName();
+    if (style != ROW_BRIEF) {
+        wcout << L", " << a.getDescription() << L"), возраст: " << a.getAgeDays(today) << L" дн., вес: " << a.getWeight() << L" кг";
+        if (a.getIsInfected()) wcout << L" (заражено)";
+        if (a.getIsDying()) wcout << L" (погибает)";
+        if (style == ROW_FULL && a.getParent1() && a.getParent2()) {
+            wcout << L" (родители: " << a.getParent1()->getName() << L" и " << a.getParent2()->getName()
+                << L", поколение " << a.getGeneration() << L", инбридинг " << a.getInbreeding() << L")";
+        }
+    }
+    else {
+        wcout << L")";
+    }
+    wcout << endl;
+}
+
+int AnimalPager::browse(const vector<AnimalPtr>& animals, int today, AnimalRowStyle style, bool selectable) {
+    AnimalQuery query;
+    while (true) {
+        vector<int> rows = selectRows(animals, query);
+        int pages = max(1, static_cast<int>((rows.size() + query.pageSize - 1) / query.pageSize));
+        query.page = min(max(query.page, 0), pages - 1);
+        int first = query.page * query.pageSize;
+        int last = min(first + query.pageSize, static_cast<int>(rows.size()));
+
+        wcout << L"Животные " << (rows.empty() ? 0 : first + 1) << L"-" << last << L" из " << rows.size()
+            << L" (страница " << query.page + 1 << L"/" << pages << L", " << SORT_NAMES[query.sort];
+        if (!query.search.empty()) wcout << L", поиск: \"" << query.search << L"\"";
+        wcout << L")\n";
+        for (int r = first; r < last; ++r) {
+            printRow(rows[r] + 1, *animals[rows[r]], today, style);
+        }
+
+        if (selectable) {
+            wcout << L"Номер животного, > / < - страница, /текст - поиск, * - сортировка, 0 - отмена: ";
+        }
+        else {
+            wcout << L"> / < - страница, /текст - поиск, * - сортировка, 0 - назад: ";
+        }
+
+        wstring line;
+        if (!getline(wcin, line)) return -1;
+        if (line.empty() && !selectable) return -1;
+
+        if (line == L">") {
+            query.page++;
+        }
+        else if (line == L"<") {
+            query.page--;
+        }
+        else if (line == L"*") {
+            query.sort = static_cast<AnimalSort>((query.sort + 1) % SORT_COUNT);
+            query.page = 0;
+        }
+        else if (!line.empty() && line[0] == L'/') {
+            query.search = line.substr(1);
+            query.page = 0;
+        }
+        else {
+            int number = parseNumber(line);
+            if (number == 0) return -1;
+            if (selectable && number >= 1 && number <= static_cast<int>(animals.size())) {
+                return number - 1;
+            }
+            wcout << L"Ошибка: неизвестная команда\n";
+        }
+    }
+}
@@ -0,0 +1,43 @@
+// Постраничные списки животных
+#pragma once
+
+#include "pen.h"
+
+// Порядок сортировки в списках животных
+enum AnimalSort { SORT_NONE, SORT_AGE, SORT_INFECTION, SORT_SPECIES, SORT_COUNT };
+// Подробность строки животного в списках
+enum AnimalRowStyle { ROW_BRIEF, ROW_DETAILED, ROW_FULL };
+
+// Названия порядков сортировки
+const vector<wstring> SORT_NAMES = {
+    L"без сортировки",
+    L"по возрасту",
+    L"по заражению",
+    L"по виду"
+};
+
+// Параметры отображения списка животных
+struct AnimalQuery {
+    int page = 0;               // Текущая страница
+    int pageSize = 10;          // Строк на странице
+    AnimalSort sort = SORT_NONE; // Порядок сортировки
+    wstring search;             // Подстрока имени или вида (пусто - все)
+};
+
+// Постраничный просмотр и выбор животных: форматируются только видимые строки
+class AnimalPager {
+public:
+    // Номера животных, подходящих под фильтр, в порядке сортировки
+    static vector<int> selectRows(const vector<AnimalPtr>& animals, const AnimalQuery& query);
+
+    // Вывод одной строки списка (возраст - на день today)
+    static void printRow(int number, const Animal& a, int today, AnimalRowStyle style);
+
+    // Номер из строки ввода: только цифры (пробелы по краям допустимы),
+    // иначе -1. "5abc" и переполнение числом не считаются
+    static int parseNumber(const wstring& line);
+
+    // Интерактивный просмотр списка. Возвращает номер выбранного животного
+    // или -1 (отмена или просмотр без выбора)
+    static int browse(const vector<AnimalPtr>& animals, int today, AnimalRowStyle style, bool selectable);
+};
@@ -0,0 +1,424 @@
+// Вольеры, очередь уборки и очередь лечения
+#include "pen.h"
+#include "zoo.h"
+
+void DirtyPenQueue::removePen(int index) {
+    queue.erase(remove(queue.begin(), queue.end(), index), queue.end());
+    for (int& other : queue) {
+        if (other > index) other--;
+    }
+}
+
+bool Pen::canAdd(const AnimalPtr& a) const {
+    if (a->getType() != allowedType) return false;
+
+    if (a->getIsHybrid()) {
+        if (a->getParent1()->getSpeciesId() == a->getParent2()->getSpeciesId()) {
+            return a->getClimate() == climate;
+        }
+        else {
+            return a->getClimate() == a->getParent1()->getClimate() ||
+                a->getClimate() == a->getParent2()->getClimate();
+        }
+    }
+    return a->getClimate() == climate && animals.size() < capacity;
+}
+
+void Pen::countSpecies(int speciesId, int delta) {
+    for (size_t i = 0; i < speciesCounts.size(); ++i) {
+        if (speciesCounts[i].first != speciesId) continue;
+        speciesCounts[i].second += delta;
+        if (speciesCounts[i].second == 0) speciesCounts.erase(speciesCounts.begin() + i);
+        return;
+    }
+    speciesCounts.push_back(make_pair(speciesId, delta));
+}
+
+void Pen::recountSpecies() {
+    speciesCounts.clear();
+    for (const auto& a : animals) countSpecies(a->getSpeciesId(), 1);
+}
+
+void Pen::addAnimal(const AnimalPtr& a) {
+    if (canAdd(a)) {
+        animals.push_back(a);
+        countSpecies(a->getSpeciesId(), 1);
+    }
+}
+
+void Pen::removeAnimal(int index) {
+    if (index >= 0 && index < static_cast<int>(animals.size())) {
+        countSpecies(animals[index]->getSpeciesId(), -1);
+        animals.erase(animals.begin() + index);
+    }
+}
+
+void Pen::own() {
+    if (!isShared()) return;
+    unordered_map<const Animal*, AnimalPtr> replaced;
+    for (AnimalPtr& a : animals) {
+        AnimalPtr copy = make_shared<Animal>(*a);
+        replaced[a.get()] = copy;
+        a = copy;
+    }
+    for (AnimalPtr& a : newInfections) {
+        auto it = replaced.find(a.get());
+        if (it != replaced.end()) a = it->second;
+    }
+    shareToken.reset();
+}
+
+wstring Pen::getDescription() const {
+    return L"Вольер для " +
+        (allowedType == HERBIVORE ? wstring(L"травоядных") : wstring(L"хищников")) +
+        L" (" + CLIMATES[static_cast<int>(climate)] + L")";
+}
+
+int Pen::getInfectedCount() const {
+    int count = 0;
+    for (const auto& a : animals) {
+        if (a->getIsInfected() && !a->getIsDying()) count++;
+    }
+    return count;
+}
+
+bool Pen::infectRandomAnimal(int currentDay, int chance) {
+    if ((!diseaseActive || getInfectedCount() == 0) &&
+        lastInfectionDay != currentDay &&
+        zooRand() % 100 < chance) {
+        own();
+        vector<AnimalPtr> healthy;
+        for (auto& a : animals) {
+            if (!a->getIsInfected() && !a->getIsDying()) healthy.push_back(a);
+        }
+        if (!healthy.empty()) {
+            auto selected = healthy[zooRand() % healthy.size()];
+            selected->setInfected(true, currentDay);
+            lastInfectionDay = currentDay;
+            diseaseActive = true;
+            newInfections.push_back(selected);
+            zooOut() << L"⚠ В вольере " << getDescription() << L" заражено: " << selected->getName() << endl;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Pen::hasActiveDisease() {
+    if (outbreakStarted) return true;
+    if (diseaseActive && getInfectedCount() == 0) diseaseActive = false;
+    return diseaseActive;
+}
+
+bool Pen::markDiseaseCheck(int checkDay) {
+    if (diseaseCheckDay >= checkDay) return false;
+    diseaseCheckDay = checkDay;
+    return true;
+}
+
+void Pen::spreadDisease(int currentDay, int spreadCount) {
+    own();
+    vector<AnimalPtr> infected;
+    for (auto& a : animals) {
+        if (a->getIsInfected() && !a->getIsDying() &&
+            a->getInfectionDay() <= currentDay - 1) {
+            infected.push_back(a);
+        }
+    }
+
+    for (auto& a : infected) {
+        vector<AnimalPtr> healthy;
+        for (auto& b : animals) {
+            if (!b->getIsInfected() && !b->getIsDying() && b->getInfectionDay() == 0)
+                healthy.push_back(b);
+        }
+
+        for (int i = 0; i < spreadCount && !healthy.empty(); i++) {
+            int idx = zooRand() % healthy.size();
+            auto newInfected = healthy[idx];
+            newInfected->setInfected(true, currentDay);
+            newInfections.push_back(newInfected);
+            zooOut() << L"⚠ В вольере " << getDescription() << L" заражено: " << newInfected->getName() << endl;
+            healthy.erase(healthy.begin() + idx);
+        }
+    }
+}
+
+bool Pen::receiveInfection(int currentDay) {
+    own();
+    vector<AnimalPtr> healthy;
+    for (auto& a : animals) {
+        if (!a->getIsInfected() && !a->getIsDying()) healthy.push_back(a);
+    }
+    if (healthy.empty()) return false;
+
+    auto selected = healthy[zooRand() % healthy.size()];
+    selected->setInfected(true, currentDay);
+    diseaseActive = true;
+    newInfections.push_back(selected);
+    zooOut() << L"⚠ Болезнь перешла в вольер " << getDescription() << L" из соседнего: " << selected->getName() << endl;
+    return true;
+}
+
+void Pen::handleOutbreak(int currentDay) {
+    int total = animals.size();
+    int infected = getInfectedCount();
+
+    if (!outbreakStarted && infected > total / 2) {
+        outbreakStarted = true;
+        outbreakDay = currentDay;
+        zooOut() << L"⚠ В вольере " << getDescription() << L" началась вспышка болезни!\n";
+    }
+}
+
+void Pen::handleDying(int maxAge, int today, int& diseaseDeaths, int& oldAgeDeaths) {
+    if (!outbreakStarted) return;
+
+    vector<AnimalPtr> survivors;
+    for (auto& a : animals) {
+        bool shouldDie = false;
+        wstring deathReason;
+
+        if (a->getIsInfected() && outbreakStarted) {
+            shouldDie = true;
+            deathReason = L"тиаравирус";
+        }
+        else if (a->canDieOfOldAge(maxAge, today)) {
+            shouldDie = true;
+            deathReason = L"старость";
+        }
+
+        if (shouldDie) {
+            zooOut() << L"⚠ В вольере " << getDescription() << L" погибло: " << a->getName() << L" (" << deathReason << L")" << endl;
+            if (a->getIsInfected()) diseaseDeaths++;
+            else oldAgeDeaths++;
+            countSpecies(a->getSpeciesId(), -1);
+        }
+        else {
+            survivors.push_back(a);
+        }
+    }
+    animals = survivors;
+
+    if (outbreakStarted && getInfectedCount() == 0) {
+        outbreakStarted = false;
+    }
+}
+
+void Pen::starve(int firstUnfed, int deadCount) {
+    int unfed = static_cast<int>(animals.size()) - firstUnfed;
+    for (int k = 0; k < deadCount; ++k) {
+        int pick = firstUnfed + k + zooRand() % (unfed - k);
+        swap(animals[firstUnfed + k], animals[pick]);
+        countSpecies(animals[firstUnfed + k]->getSpeciesId(), -1);
+    }
+    animals.erase(animals.begin() + firstUnfed, animals.begin() + firstUnfed + deadCount);
+}
+
+void Pen::updateCleanliness(int index, DirtyPenQueue& dirtyPens) {
+    if (!animals.empty() && zooRand() % 3 == 0) {
+        if (isClean) dirtyPens.push(index);
+        isClean = false;
+        zooOut() << L"Вольер " << getDescription() << L" стал грязным." << endl;
+    }
+}
+
+void TriageQueue::prune(const vector<Pen>& pens, vector<AnimalPtr>& found) {
+    stable_sort(entries.begin(), entries.end(), [](const TriageEntry& x, const TriageEntry& y) {
+        return x.pen < y.pen;
+    });
+
+    vector<TriageEntry> kept;
+    kept.reserve(entries.size());
+    found.clear();
+    size_t i = 0;
+    while (i < entries.size()) {
+        int pen = entries[i].pen;
+        size_t groupEnd = i;
+        while (groupEnd < entries.size() && entries[groupEnd].pen == pen) groupEnd++;
+
+        if (pen >= 0 && pen < static_cast<int>(pens.size())) {
+            unordered_map<uint64_t, AnimalPtr> present;
+            for (const auto& a : pens[pen].getAnimals()) present[a->getPedigreeId()] = a;
+            for (size_t j = i; j < groupEnd; ++j) {
+                auto it = present.find(entries[j].pedigreeId);
+                if (it == present.end()) continue;
+                AnimalPtr a = it->second;
+                if (a->getIsInfected() && a->getInfectionDay() == entries[j].infectionDay) {
+                    kept.push_back(entries[j]);
+                    found.push_back(a);
+                    present.erase(it);
+                }
+            }
+        }
+        i = groupEnd;
+    }
+    entries.swap(kept);
+}
+
+// Животные записей после того, как их вольеры стали собственными
+static void ownAndResolve(const vector<TriageEntry>& chosen, vector<Pen>& pens, vector<AnimalPtr>& animals) {
+    for (size_t k = 0; k < chosen.size(); ++k) {
+        Pen& pen = pens[chosen[k].pen];
+        if (!pen.isShared()) continue;
+        pen.own();
+        for (const auto& a : pen.getAnimals()) {
+            if (a->getPedigreeId() == chosen[k].pedigreeId) {
+                animals[k] = a;
+                break;
+            }
+        }
+    }
+}
+
+vector<AnimalPtr> TriageQueue::takeMostUrgent(int capacity, vector<Pen>& pens, int currentDay) {
+    vector<AnimalPtr> found;
+    prune(pens, found);
+    vector<AnimalPtr> taken;
+    if (capacity <= 0 || entries.empty()) return taken;
+
+    map<int, int> infectedPerPen;
+    for (const auto& e : entries) infectedPerPen[e.pen]++;
+
+    // При равенстве раньше лечится старшее животное (меньший номер в родословной)
+    typedef tuple<double, int, double, uint64_t, size_t> Key;
+    vector<Key> keys;
+    keys.reserve(entries.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const Pen& pen = pens[entries[i].pen];
+        double risk = pen.getOutbreakStarted() ? 2.0 :
+            static_cast<double>(infectedPerPen[entries[i].pen]) / max(pen.getAnimalCount(), 1);
+        keys.push_back(Key(-risk, -(currentDay - entries[i].infectionDay), -found[i]->getPrice(),
+            entries[i].pedigreeId, i));
+    }
+
+    size_t count = min(static_cast<size_t>(capacity), keys.size());
+    partial_sort(keys.begin(), keys.begin() + count, keys.end());
+
+    vector<bool> chosen(entries.size(), false);
+    vector<TriageEntry> takenEntries;
+    for (size_t k = 0; k < count; ++k) {
+        size_t idx = get<4>(keys[k]);
+        chosen[idx] = true;
+        takenEntries.push_back(entries[idx]);
+        taken.push_back(found[idx]);
+    }
+    vector<TriageEntry> rest;
+    rest.reserve(entries.size() - count);
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (!chosen[i]) rest.push_back(entries[i]);
+    }
+    entries.swap(rest);
+    ownAndResolve(takenEntries, pens, taken);
+    return taken;
+}
+
+vector<AnimalPtr> TriageQueue::pending(vector<Pen>& pens) {
+    vector<AnimalPtr> result;
+    prune(pens, result);
+    ownAndResolve(entries, pens, result);
+    return result;
+}
+
+void TriageQueue::removePen(int index) {
+    entries.erase(remove_if(entries.begin(), entries.end(), [index](const TriageEntry& e) {
+        return e.pen == index;
+    }), entries.end());
+    for (auto& e : entries) {
+        if (e.pen > index) e.pen--;
+    }
+}
+
+// Выбор вольеров для уборки: в порядке загрязнения или по приоритету.
+// Просматриваются только грязные вольеры
+vector<int> DirtyPenQueue::take(int count, CleaningPriority priority, const vector<Pen>& pens) {
+    vector<int> taken;
+    if (count <= 0 || queue.empty()) return taken;
+
+    if (priority != CLEAN_OLDEST_FIRST && static_cast<int>(queue.size()) > count) {
+        vector<pair<int, int>> keyed;
+        keyed.reserve(queue.size());
+        for (size_t pos = 0; pos < queue.size(); ++pos) {
+            const Pen& pen = pens[queue[pos]];
+            int key = priority == CLEAN_MOST_ANIMALS ? pen.getAnimalCount() : pen.getInfectedCount();
+            keyed.push_back(make_pair(-key, static_cast<int>(pos)));
+        }
+        // При равных ключах раньше убирается вольер, загрязнившийся раньше
+        partial_sort(keyed.begin(), keyed.begin() + count, keyed.end());
+        vector<bool> chosen(queue.size(), false);
+        for (int i = 0; i < count; ++i) {
+            chosen[keyed[i].second] = true;
+            taken.push_back(queue[keyed[i].second]);
+        }
+        deque<int> rest;
+        for (size_t pos = 0; pos < queue.size(); ++pos) {
+            if (!chosen[pos]) rest.push_back(queue[pos]);
+        }
+        queue.swap(rest);
+        return taken;
+    }
+
+    while (count-- > 0 && !queue.empty()) {
+        taken.push_back(queue.front());
+        queue.pop_front();
+    }
+    return taken;
+}
+
+// Реализация метода ручного скрещивания для класса Pen
+bool Pen::tryManualBreeding(AnimalPtr a1, AnimalPtr a2, Zoo& zoo) {
+    if (animals.size() >= capacity) {
+        wcout << L"Нет места в этом вольере для потомства\n";
+        return false;
+    }
+
+    auto offspring = Animal::breed(a1, a2, zoo.getDay());
+    if (!offspring) {
+        return false;
+    }
+
+    vector<Pen*> suitablePens;
+    for (auto& pen : zoo.getPens()) {
+        if (pen.canAdd(offspring)) {
+            suitablePens.push_back(&pen);
+        }
+    }
+
+    if (suitablePens.empty()) {
+        wcout << L"Нет подходящих вольеров для потомства\n";
+        return false;
+    }
+
+    wcout << L"\nВыберите вольер для потомства:\n";
+    for (size_t i = 0; i < suitablePens.size(); ++i) {
+        wcout << (i + 1) << L". " << suitablePens[i]->getDescription() << L" ("
+            << suitablePens[i]->getAnimalCount() << L"/" << suitablePens[i]->getCapacity() << L")\n";
+    }
+
+    int penChoice;
+    while (true) {
+        wcout << L"Вольер (1-" << suitablePens.size() << L"): ";
+        if (wcin >> penChoice) {
+            if (penChoice >= 1 && penChoice <= static_cast<int>(suitablePens.size())) break;
+        }
+        wcin.clear();
+        wcin.ignore(numeric_limits<streamsize>::max(), L'\n');
+        wcout << L"Ошибка: введите число от 1 до " << suitablePens.size() << endl;
+    }
+    wcin.ignore();
+
+    suitablePens[penChoice - 1]->addAnimal(offspring);
+    zoo.getGenetics().record(*offspring);
+    wstring eventMsg = offspring->getIsHybrid() ?
+        L"Родился новый гибрид: " + offspring->getName() + L" (от " + a1->getName() + L" и " + a2->getName() + L")" :
+        L"Родилось новое животное: " + offspring->getName() + L" (от " + a1->getName() + L" и " + a2->getName() + L")";
+
+    wcout << L"🎉 " << eventMsg << endl;
+    if (offspring->getInbreeding() >= 0.0625) {
+        wcout << L"Внимание: близкородственное скрещивание, инбридинг " << offspring->getInbreeding() << endl;
+    }
+    wcout << L"Помещено в вольер: " << suitablePens[penChoice - 1]->getDescription() << endl;
+    zoo.addEvent(eventMsg);
+
+    return true;
+}
@@ -0,0 +1,194 @@
+// Вольеры, очередь уборки и очередь лечения
+#pragma once
+
+#include "animal.h"
+
+// Предварительное объявление класса Zoo
+class Zoo;
+class Pen;
+
+// Порядок уборки грязных вольеров
+enum CleaningPriority { CLEAN_OLDEST_FIRST, CLEAN_MOST_ANIMALS, CLEAN_MOST_INFECTED };
+
+// Названия порядков уборки
+const vector<wstring> CLEANING_PRIORITY_NAMES = {
+    L"В порядке загрязнения",
+    L"Сначала вольеры с большим числом животных",
+    L"Сначала вольеры с большим числом зараженных"
+};
+
+// Очередь грязных вольеров: вольер попадает в нее, когда становится грязным,
+// и уборщики берут работу из очереди, не просматривая все вольеры
+class DirtyPenQueue {
+private:
+    deque<int> queue;           // Номера грязных вольеров в порядке загрязнения
+
+public:
+    // Добавление вольера, ставшего грязным
+    void push(int index) { queue.push_back(index); }
+
+    // Выбор до count вольеров для уборки (с удалением из очереди)
+    vector<int> take(int count, CleaningPriority priority, const vector<Pen>& pens);
+
+    // Удаление вольера из очереди со сдвигом номеров следующих вольеров
+    void removePen(int index);
+
+    size_t size() const { return queue.size(); }
+    bool empty() const { return queue.empty(); }
+};
+
+// Класс, представляющий вольер для животных
+class Pen {
+private:
+    int id;                     // Номер вольера в зоопарке (не меняется при сносе других вольеров)
+    int capacity;               // Вместимость вольера
+    AnimalType allowedType;     // Разрешенный тип животных
+    Climate climate;            // Климат вольера
+    vector<AnimalPtr> animals;  // Животные в вольере
+    vector<pair<int, int>> speciesCounts; // Животных по видам (номер вида, число); ведется при добавлении и удалении
+    bool isClean = true;        // Чистота вольера
+    int lastInfectionDay = 0;   // Последний день заражения
+    bool outbreakStarted = false; // Началась ли эпидемия
+    int outbreakDay = 0;        // День начала эпидемии
+    bool diseaseActive = false; // Могут ли в вольере быть зараженные (заражение идет только через методы вольера)
+    int diseaseCheckDay = -1;   // День, на который запланирована проверка болезни
+    vector<AnimalPtr> newInfections; // Заразившиеся с последней передачи в очередь лечения
+    shared_ptr<char> shareToken; // Общий у вольеров веток одного зоопарка, пока животные не скопированы
+
+    // Учет добавленного (delta = 1) или удаленного (delta = -1) животного
+    void countSpecies(int speciesId, int delta);
+
+    // Пересчет видов по животным (после прямой правки списка)
+    void recountSpecies();
+
+    friend class ReferenceTick;
+
+public:
+    // Конструктор вольера
+    Pen(int penId, int cap, AnimalType type, Climate cl)
+        : id(penId), capacity(cap), allowedType(type), climate(cl) {}
+
+    // Проверка, можно ли добавить животное в вольер
+    bool canAdd(const AnimalPtr& a) const;
+
+    // Добавление животного в вольер
+    void addAnimal(const AnimalPtr& a);
+
+    // Удаление животного из вольера по индексу
+    void removeAnimal(int index);
+
+    // Ветвление зоопарка: животные вольера становятся общими с веткой
+    void share() {
+        if (!shareToken) shareToken = make_shared<char>(0);
+    }
+
+    // Животные общие с вольером другой ветки (копия вольера еще жива и не менялась)
+    bool isShared() const {
+        return shareToken && shareToken.use_count() > 1;
+    }
+
+    // Собственные копии общих животных перед их изменением (родословная
+    // остается общей). Вызывается самим вольером и лечением только там, где
+    // животные действительно меняются, поэтому ветка копирует лишь вольеры,
+    // в которых что-то произошло
+    void own();
+
+    // Геттеры
+    const vector<AnimalPtr>& getAnimals() const { return animals; }
+    const vector<pair<int, int>>& getSpeciesCounts() const { return speciesCounts; }
+    int getId() const { return id; }
+    int getAnimalCount() const { return animals.size(); }
+    AnimalType getAllowedType() const { return allowedType; }
+    Climate getClimate() const { return climate; }
+    int getCapacity() const { return capacity; }
+    bool getIsClean() const { return isClean; }
+    void setClean(bool clean) { isClean = clean; }
+    bool getOutbreakStarted() const { return outbreakStarted; }
+
+    // Передача новых заражений (список очищается)
+    void takeNewInfections(vector<AnimalPtr>& out) {
+        out.insert(out.end(), newInfections.begin(), newInfections.end());
+        newInfections.clear();
+    }
+
+    // Получение описания вольера
+    wstring getDescription() const;
+
+    // Подсчет зараженных животных в вольере
+    int getInfectedCount() const;
+
+    // Заражение случайного животного с шансом chance % (true, если животное заразилось)
+    bool infectRandomAnimal(int currentDay, int chance);
+
+    // Есть ли в вольере незавершенная болезнь (зараженные или вспышка)
+    bool hasActiveDisease();
+
+    // Планирование проверки болезни (без повторов на один день)
+    bool markDiseaseCheck(int checkDay);
+
+    // Распространение болезни в вольере: каждый больной заражает до spreadCount здоровых
+    void spreadDisease(int currentDay, int spreadCount);
+
+    // Заражение от соседнего вольера (true, если заразилось животное)
+    bool receiveInfection(int currentDay);
+
+    // Обработка вспышки болезни
+    void handleOutbreak(int currentDay);
+
+    // Обработка умирающих животных (погибшие добавляются в счетчики по причинам);
+    // today - день, по которому считается возраст
+    void handleDying(int maxAge, int today, int& diseaseDeaths, int& oldAgeDeaths);
+
+    // Гибель deadCount случайных животных из оставшихся без корма
+    // (животные с номера firstUnfed до конца списка)
+    void starve(int firstUnfed, int deadCount);
+
+    // Обновление состояния чистоты вольера (ставший грязным вольер попадает в очередь уборки)
+    void updateCleanliness(int index, DirtyPenQueue& dirtyPens);
+
+    // Попытка ручного скрещивания животных
+    bool tryManualBreeding(AnimalPtr a1, AnimalPtr a2, Zoo& zoo);
+};
+
+// Запись очереди лечения. Животное хранится номером в родословной: после
+// Pen::own в вольере лежит копия животного с тем же номером
+struct TriageEntry {
+    uint64_t pedigreeId;        // Зараженное животное
+    int pen;                    // Номер вольера
+    int infectionDay;           // День заражения (для отсева повторных заражений)
+};
+
+// Очередь лечения: животные попадают в нее в момент заражения, ветеринары
+// лечат самых срочных. Вылеченные, погибшие и проданные животные отсеиваются
+// при обработке очереди, так что работа пропорциональна числу зараженных
+class TriageQueue {
+private:
+    vector<TriageEntry> entries;
+
+public:
+    // Добавление заразившегося животного
+    void add(const AnimalPtr& animal, int pen) {
+        TriageEntry e = { animal->getPedigreeId(), pen, animal->getInfectionDay() };
+        entries.push_back(e);
+    }
+
+    // Отсев записей: остаются животные, которые еще заражены и находятся в своем вольере.
+    // Просматриваются только вольеры, где есть записи; found получает животных записей
+    void prune(const vector<Pen>& pens, vector<AnimalPtr>& found);
+
+    // Выбор до capacity самых срочных животных (с удалением из очереди).
+    // Приоритет: риск вольера (вспышка, затем доля зараженных), дни болезни, цена,
+    // номер в родословной.
+    // Вольеры выбранных животных становятся собственными (Pen::own): их будут лечить
+    vector<AnimalPtr> takeMostUrgent(int capacity, vector<Pen>& pens, int currentDay);
+
+    // Все зараженные животные из очереди (очередь не меняется); их вольеры
+    // становятся собственными
+    vector<AnimalPtr> pending(vector<Pen>& pens);
+
+    // Удаление записей вольера и сдвиг номеров следующих вольеров
+    void removePen(int index);
+
+    void clear() { entries.clear(); }
+    size_t size() const { return entries.size(); }
+};
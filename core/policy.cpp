@@ -0,0 +1,223 @@
+// Автопилот, прогоны без консоли и поиск стратегии
+#include "policy.h"
+
+void PolicyPilot::staff(Zoo& zoo, WorkerType type, int target) {
+    WorkerRoster& workers = zoo.getWorkers();
+    while (workers.count(type) < target) {
+        workers.hire(type, WORKER_TYPES[type] + L" " + to_wstring(workers.count(type) + 1));
+    }
+    while (workers.count(type) > target) {
+        // Последний работник должности в сквозной нумерации
+        int index = -1;
+        for (int role = 0; role <= type; ++role) index += workers.count(static_cast<WorkerType>(role));
+        zoo.removeWorker(index);
+    }
+}
+
+void PolicyPilot::act(Zoo& zoo, const Policy& policy) {
+    if (zoo.getDay() == 0 && policy.loanAmount > 0) {
+        zoo.takeLoan(policy.loanAmount, max(policy.loanDays, 1));
+    }
+
+    staff(zoo, VET, static_cast<int>(ceil(policy.vetRatio * zoo.calculateNeededVets())));
+    staff(zoo, CLEANER, static_cast<int>(ceil(policy.cleanerRatio * zoo.calculateNeededCleaners())));
+    staff(zoo, FEEDER, static_cast<int>(ceil(policy.feederRatio * zoo.calculateNeededFeeders())));
+
+    // Неприкосновенный запас - неделя зарплат
+    double reserve = zoo.getWorkers().totalSalary() * 7;
+
+    // Покупка животных с рынка, при необходимости со строительством вольера
+    const vector<AnimalPtr>& offers = zoo.getMarket().getAnimals();
+    for (int i = static_cast<int>(offers.size()) - 1; i >= 0 && zoo.canBuyAnimal(); --i) {
+        AnimalPtr offer = offers[i];
+        double price = zoo.buyPrice(*offer);
+        Pen* pen = zoo.findPenFor(offer);
+        if (!pen) {
+            if (zoo.getMoney() - policy.penCapacity * 10 - price < reserve) continue;
+            if (!zoo.buildPen(policy.penCapacity, offer->getType(), offer->getClimate())) continue;
+            pen = &zoo.getPens().back();
+        }
+        if (zoo.getMoney() - price < reserve) continue;
+        zoo.buyFromMarket(i, *pen);
+    }
+
+    // Корм на заданное число дней вперед
+    int eaters[2] = {};
+    for (const Pen& pen : zoo.getPens()) eaters[pen.getAllowedType()] += pen.getAnimalCount();
+    for (int diet = 0; diet < 2; ++diet) {
+        int shortfall = eaters[diet] * policy.foodDays - zoo.getFood(static_cast<AnimalType>(diet));
+        shortfall = static_cast<int>(min<double>(shortfall, zoo.getMoney()));
+        if (shortfall > 0) zoo.buyFood(static_cast<AnimalType>(diet), shortfall);
+    }
+
+    if (policy.advertising > 0 && zoo.getMoney() - policy.advertising >= reserve) {
+        zoo.advertise(policy.advertising);
+    }
+}
+
+void PolicyOptimizer::evaluate(vector<Candidate>& candidates, const vector<unsigned>& seeds) const {
+    vector<int> pending;
+    for (int i = 0; i < static_cast<int>(candidates.size()); ++i) {
+        if (!candidates[i].evaluated) pending.push_back(i);
+    }
+    int jobs = static_cast<int>(pending.size()) * rollouts;
+    vector<RolloutResult> results(jobs);
+    vector<Policy> policies;
+    for (int i : pending) policies.push_back(decodePolicy(candidates[i].genes));
+
+    parallelFor(jobs, threads, [&](int j) {
+        results[j] = runRollout(policies[j / rollouts], seeds[j % rollouts], Scenario());
+    });
+
+    for (size_t k = 0; k < pending.size(); ++k) {
+        Candidate& c = candidates[pending[k]];
+        c.score = 0.0;
+        c.bankruptcies = 0;
+        for (int r = 0; r < rollouts; ++r) {
+            const RolloutResult& result = results[k * rollouts + r];
+            c.score += result.netWorth;
+            if (result.status == BANKRUPT) {
+                c.score -= BANKRUPTCY_PENALTY;
+                c.bankruptcies++;
+            }
+        }
+        c.score /= rollouts;
+        c.evaluated = true;
+    }
+}
+
+PolicyOptimizer::Candidate PolicyOptimizer::run(const function<void(int, const Candidate&)>& progress) const {
+    mt19937 engine(seed);
+    uniform_real_distribution<double> uniform(0.0, 1.0);
+    normal_distribution<double> gauss(0.0, 1.0);
+
+    vector<unsigned> seeds(rollouts);
+    for (unsigned& s : seeds) s = engine();
+
+    int size = max(population, 4);
+    int elite = max(2, size / 4);
+    vector<Candidate> candidates(size);
+    candidates[0].genes = encodePolicy(Policy());
+    for (int i = 1; i < size; ++i) {
+        candidates[i].genes.resize(POLICY_PARAMS.size());
+        for (double& g : candidates[i].genes) g = uniform(engine);
+    }
+
+    double sigma = 0.2;
+    for (int gen = 0; gen < generations; ++gen) {
+        evaluate(candidates, seeds);
+        stable_sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+            return a.score > b.score;
+        });
+        if (progress) progress(gen, candidates[0]);
+        if (gen + 1 == generations) break;
+
+        // Лучшие переходят без изменений, остальные - потомки лучших
+        for (int i = elite; i < size; ++i) {
+            const Candidate& a = candidates[engine() % elite];
+            const Candidate& b = candidates[engine() % elite];
+            Candidate child;
+            child.genes.resize(POLICY_PARAMS.size());
+            for (size_t g = 0; g < child.genes.size(); ++g) {
+                double gene = uniform(engine) < 0.5 ? a.genes[g] : b.genes[g];
+                child.genes[g] = min(max(gene + sigma * gauss(engine), 0.0), 1.0);
+            }
+            candidates[i] = child;
+        }
+        sigma *= 0.85;
+    }
+    return candidates[0];
+}
+
+void parallelFor(int jobs, int threads, const function<void(int)>& body) {
+    atomic<int> nextJob(0);
+    auto worker = [&]() {
+        for (int j = nextJob++; j < jobs; j = nextJob++) body(j);
+    };
+    int workers = min(max(threads, 1), max(jobs, 1));
+    vector<thread> pool;
+    for (int t = 1; t < workers; ++t) pool.emplace_back(worker);
+    worker();
+    for (thread& t : pool) t.join();
+}
+
+Policy decodePolicy(const vector<double>& x) {
+    auto value = [&](int i) { return POLICY_PARAMS[i].low + x[i] * (POLICY_PARAMS[i].high - POLICY_PARAMS[i].low); };
+    Policy p;
+    p.penCapacity = static_cast<int>(lround(value(0)));
+    p.foodDays = static_cast<int>(lround(value(1)));
+    p.advertising = static_cast<int>(lround(value(2)));
+    p.vetRatio = value(3);
+    p.cleanerRatio = value(4);
+    p.feederRatio = value(5);
+    p.loanAmount = static_cast<int>(lround(value(6) / 500.0)) * 500;
+    p.loanDays = static_cast<int>(lround(value(7)));
+    return p;
+}
+
+vector<double> encodePolicy(const Policy& p) {
+    double values[] = { static_cast<double>(p.penCapacity), static_cast<double>(p.foodDays),
+        static_cast<double>(p.advertising), p.vetRatio, p.cleanerRatio, p.feederRatio,
+        static_cast<double>(p.loanAmount), static_cast<double>(p.loanDays) };
+    vector<double> x(POLICY_PARAMS.size());
+    for (size_t i = 0; i < x.size(); ++i) {
+        x[i] = (values[i] - POLICY_PARAMS[i].low) / (POLICY_PARAMS[i].high - POLICY_PARAMS[i].low);
+        x[i] = min(max(x[i], 0.0), 1.0);
+    }
+    return x;
+}
+
+namespace {
+
+// Итог прогона по состоянию зоопарка
+RolloutResult summarize(Zoo& zoo) {
+    RolloutResult result;
+    result.status = zoo.getStatus();
+    result.days = zoo.getDay();
+    result.netWorth = zoo.getMoney() - zoo.getDebt();
+    for (const Pen& pen : zoo.getPens()) {
+        for (const auto& a : pen.getAnimals()) result.netWorth += a->getPrice();
+    }
+    return result;
+}
+
+} // namespace
+
+RolloutResult runRollout(const Policy& policy, unsigned seed, const Scenario& scenario) {
+    bool wasQuiet = zooQuiet();
+    zooQuiet() = true;
+    zooSeed(seed);
+
+    Zoo zoo(L"Прогон", L"Директор", scenario);
+    while (!zoo.isOver()) {
+        PolicyPilot::act(zoo, policy);
+        zoo.nextDay();
+    }
+
+    RolloutResult result = summarize(zoo);
+    zooQuiet() = wasQuiet;
+    return result;
+}
+
+vector<RolloutResult> exploreFutures(Zoo& zoo, const Policy& policy, int branches, int days, unsigned seed, int threads) {
+    // Ветки создаются заранее в одном потоке: ветвление помечает вольеры исходного зоопарка
+    vector<unique_ptr<Zoo>> forks;
+    for (int b = 0; b < branches; ++b) forks.emplace_back(new Zoo(zoo.fork()));
+
+    vector<RolloutResult> results(forks.size());
+    parallelFor(static_cast<int>(forks.size()), threads, [&](int b) {
+        bool wasQuiet = zooQuiet();
+        mt19937 saved = zooEngine();
+        zooQuiet() = true;
+        zooSeed(seed + b);
+        Zoo& branch = *forks[b];
+        for (int d = 0; d < days && !branch.isOver(); ++d) {
+            PolicyPilot::act(branch, policy);
+            branch.nextDay();
+        }
+        results[b] = summarize(branch);
+        zooEngine() = saved;
+        zooQuiet() = wasQuiet;
+    });
+    return results;
+}
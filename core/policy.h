@@ -0,0 +1,100 @@
+// Автопилот, прогоны без консоли и поиск стратегии
+#pragma once
+
+#include "zoo.h"
+
+// Выполнение заданий 0..jobs-1 в нескольких потоках (задания разбираются
+// по одному из общего счетчика, текущий поток тоже работает)
+void parallelFor(int jobs, int threads, const function<void(int)>& body);
+
+// Стратегия управления зоопарком для автопилота и оптимизатора
+struct Policy {
+    int penCapacity = 10;       // Вместимость строящихся вольеров (стоимость cap * 10)
+    int foodDays = 3;           // Запас корма в днях потребления
+    int advertising = 0;        // Ежедневные расходы на рекламу
+    double vetRatio = 1.0;      // Доля от рекомендуемого числа ветеринаров
+    double cleanerRatio = 1.0;  // Доля от рекомендуемого числа уборщиков
+    double feederRatio = 1.0;   // Доля от рекомендуемого числа кормильщиков
+    int loanAmount = 0;         // Кредит в первый день (0 - без кредита)
+    int loanDays = 10;          // Срок кредита
+};
+
+// Параметр стратегии для поиска: название и границы
+struct PolicyParam {
+    const wchar_t* name;
+    double low;
+    double high;
+};
+
+const vector<PolicyParam> POLICY_PARAMS = {
+    { L"Вместимость вольера", 1, 100 },
+    { L"Запас корма (дней)", 0, 14 },
+    { L"Реклама в день", 0, 500 },
+    { L"Доля ветеринаров", 0, 2 },
+    { L"Доля уборщиков", 0, 2 },
+    { L"Доля кормильщиков", 0, 2 },
+    { L"Кредит", 0, 20000 },
+    { L"Срок кредита", 1, 50 }
+};
+
+// Перевод вектора параметров (каждый в 0..1) в стратегию и обратно
+Policy decodePolicy(const vector<double>& x);
+
+vector<double> encodePolicy(const Policy& p);
+
+// Автопилот: действия игрока перед ходом по заданной стратегии
+class PolicyPilot {
+private:
+    // Доведение числа работников должности до целевого
+    static void staff(Zoo& zoo, WorkerType type, int target);
+
+public:
+    static void act(Zoo& zoo, const Policy& policy);
+};
+
+// Итог одного прогона
+struct RolloutResult {
+    GameStatus status = RUNNING;
+    int days = 0;
+    double netWorth = 0.0;      // Деньги - долг + стоимость животных
+};
+
+// Прогон без консоли: зоопарк с нуля под управлением автопилота. Генератор
+// потока заново засевается, поэтому прогон с тем же зерном повторяется точно
+RolloutResult runRollout(const Policy& policy, unsigned seed, const Scenario& scenario);
+
+// Возможные будущие одного состояния: ветки зоопарка (Zoo::fork) проживают
+// до days дней под автопилотом, ветка b - на зерне seed + b. Ветки
+// распределяются по потокам, исходный зоопарк не меняется
+vector<RolloutResult> exploreFutures(Zoo& zoo, const Policy& policy, int branches, int days, unsigned seed, int threads);
+
+// Поиск стратегии генетическим алгоритмом. Каждый кандидат оценивается
+// средним итогом по одним и тем же зернам прогонов (общие случайные числа:
+// разница кандидатов не тонет в шуме). Прогоны всех кандидатов поколения
+// распределяются по потокам
+class PolicyOptimizer {
+public:
+    int population = 24;        // Кандидатов в поколении
+    int generations = 15;       // Число поколений
+    int rollouts = 8;           // Прогонов на кандидата
+    int threads = 1;            // Потоков
+    unsigned seed = 1;          // Зерно поиска и прогонов
+
+    // Лучший найденный кандидат
+    struct Candidate {
+        vector<double> genes;
+        double score = 0.0;
+        int bankruptcies = 0;
+        bool evaluated = false;
+    };
+
+private:
+    static const int BANKRUPTCY_PENALTY = 100000;
+
+    // Оценка еще не оцененных кандидатов
+    void evaluate(vector<Candidate>& candidates, const vector<unsigned>& seeds) const;
+
+public:
+    // Поиск; progress вызывается после каждого поколения с лучшим кандидатом
+    Candidate run(const function<void(int, const Candidate&)>& progress) const;
+};
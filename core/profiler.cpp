@@ -0,0 +1,43 @@
+// Профилирование фаз дневного хода (сборка с ZOO_PROFILE)
+#include "profiler.h"
+
+#ifdef ZOO_PROFILE
+long long DayProfiler::percentile(const vector<long long>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    size_t idx = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[idx];
+}
+
+void DayProfiler::endDay() {
+    for (int i = 0; i < PHASE_COUNT; ++i) {
+        samples[i].push_back(dayNanos[i]);
+        dayNanos[i] = 0;
+    }
+}
+
+void DayProfiler::report(wostream& out) const {
+    long long grandTotal = 0;
+    for (int i = 0; i < PHASE_COUNT; ++i) {
+        for (long long v : samples[i]) grandTotal += v;
+    }
+
+    out << L"\nПрофиль дневного хода (" << samples[0].size() << L" дн., мкс):\n";
+    out << left << setw(20) << L"Фаза" << right << setw(10) << L"p50" << setw(10) << L"p90"
+        << setw(10) << L"p99" << setw(10) << L"max" << setw(8) << L"%" << setw(12) << L"объектов" << endl;
+    for (int i = 0; i < PHASE_COUNT; ++i) {
+        vector<long long> sorted = samples[i];
+        sort(sorted.begin(), sorted.end());
+        long long total = 0;
+        for (long long v : sorted) total += v;
+        out << left << setw(20) << PHASE_NAMES[i] << right << fixed << setprecision(1)
+            << setw(10) << percentile(sorted, 0.50) / 1000.0
+            << setw(10) << percentile(sorted, 0.90) / 1000.0
+            << setw(10) << percentile(sorted, 0.99) / 1000.0
+            << setw(10) << (sorted.empty() ? 0 : sorted.back()) / 1000.0
+            << setw(8) << (grandTotal > 0 ? 100.0 * total / grandTotal : 0.0)
+            << setw(12) << counters[i] << endl;
+    }
+    out.unsetf(ios::fixed);
+    out << setprecision(6);
+}
+#endif
@@ -0,0 +1,81 @@
+// Профилирование фаз дневного хода (сборка с ZOO_PROFILE)
+#pragma once
+
+#include "common.h"
+
+// Фазы дневного хода (для профилирования)
+enum TickPhase {
+    PHASE_DEBT, PHASE_CLEANLINESS, PHASE_DISEASE, PHASE_AUTO_TREAT,
+    PHASE_DYING, PHASE_FEEDING, PHASE_CLEANING, PHASE_POPULARITY, PHASE_SALARIES,
+    PHASE_INCOME, PHASE_MARKET, PHASE_RANDOM_EVENTS, PHASE_COUNT
+};
+
+// Названия фаз дневного хода
+const vector<wstring> PHASE_NAMES = {
+    L"Долг",
+    L"Чистота",
+    L"Болезни",
+    L"Автолечение",
+    L"Гибель",
+    L"Кормление",
+    L"Уборка",
+    L"Популярность",
+    L"Зарплаты",
+    L"Доход",
+    L"Рынок",
+    L"Случайные события"
+};
+
+// Профилирование дневного хода включается при сборке с -DZOO_PROFILE,
+// без него таймеры и счетчики не попадают в код
+#ifdef ZOO_PROFILE
+// Класс, собирающий время и счетчики фаз за каждый день
+class DayProfiler {
+private:
+    long long dayNanos[PHASE_COUNT] = {};    // Время фаз за текущий день
+    long long counters[PHASE_COUNT] = {};    // Обработано объектов по фазам за игру
+    vector<long long> samples[PHASE_COUNT];  // Время фаз по дням
+
+    // Процентиль по отсортированной выборке
+    static long long percentile(const vector<long long>& sorted, double p);
+
+public:
+    // Добавление времени фазы
+    void addTime(TickPhase phase, long long nanos) { dayNanos[phase] += nanos; }
+
+    // Добавление счетчика обработанных объектов
+    void addCount(TickPhase phase, long long n) { counters[phase] += n; }
+
+    // Завершение дня: время фаз переносится в выборку
+    void endDay();
+
+    // Отчет по фазам: процентили времени за день в микросекундах
+    void report(wostream& out) const;
+};
+
+// Таймер, добавляющий время своей области видимости к фазе
+class ScopedPhaseTimer {
+private:
+    DayProfiler& profiler;
+    TickPhase phase;
+    chrono::steady_clock::time_point start;
+
+public:
+    ScopedPhaseTimer(DayProfiler& p, TickPhase ph)
+        : profiler(p), phase(ph), start(chrono::steady_clock::now()) {}
+
+    ~ScopedPhaseTimer() {
+        profiler.addTime(phase, chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
+    }
+};
+
+#define ZOO_CONCAT_IMPL(a, b) a##b
+#define ZOO_CONCAT(a, b) ZOO_CONCAT_IMPL(a, b)
+#define ZOO_PHASE_SCOPE(profiler, phase) ScopedPhaseTimer ZOO_CONCAT(phaseTimer_, __LINE__)((profiler), (phase))
+#define ZOO_PROFILE_COUNT(profiler, phase, n) (profiler).addCount((phase), (n))
+#define ZOO_PROFILE_END_DAY(profiler) (profiler).endDay()
+#else
+#define ZOO_PHASE_SCOPE(profiler, phase) ((void)0)
+#define ZOO_PROFILE_COUNT(profiler, phase, n) ((void)0)
+#define ZOO_PROFILE_END_DAY(profiler) ((void)0)
+#endif
@@ -0,0 +1,689 @@
+// Эталонный дневной ход и дифференциальная проверка
+#include "reference.h"
+
+vector<AnimalPtr> ReferenceTick::healthyOf(const Pen& pen) {
+    vector<AnimalPtr> healthy;
+    for (const auto& a : pen.animals) {
+        if (!a->isInfected && !a->isDying) healthy.push_back(a);
+    }
+    return healthy;
+}
+
+bool ReferenceTick::infectRandomAnimal(Pen& pen, int day, int chance) {
+    if (pen.getInfectedCount() == 0 && pen.lastInfectionDay != day && zooRand() % 100 < chance) {
+        vector<AnimalPtr> healthy = healthyOf(pen);
+        if (!healthy.empty()) {
+            AnimalPtr selected = healthy[zooRand() % healthy.size()];
+            selected->setInfected(true, day);
+            pen.lastInfectionDay = day;
+            return true;
+        }
+    }
+    return false;
+}
+
+void ReferenceTick::spreadDisease(Pen& pen, int day, int spreadCount) {
+    vector<AnimalPtr> infected;
+    for (const auto& a : pen.animals) {
+        if (a->isInfected && !a->isDying && a->infectionDay <= day - 1) infected.push_back(a);
+    }
+    for (size_t k = 0; k < infected.size(); ++k) {
+        vector<AnimalPtr> healthy;
+        for (const auto& b : pen.animals) {
+            if (!b->isInfected && !b->isDying && b->infectionDay == 0) healthy.push_back(b);
+        }
+        for (int i = 0; i < spreadCount && !healthy.empty(); i++) {
+            int idx = zooRand() % healthy.size();
+            healthy[idx]->setInfected(true, day);
+            healthy.erase(healthy.begin() + idx);
+        }
+    }
+}
+
+bool ReferenceTick::receiveInfection(Pen& pen, int day) {
+    vector<AnimalPtr> healthy = healthyOf(pen);
+    if (healthy.empty()) return false;
+    AnimalPtr selected = healthy[zooRand() % healthy.size()];
+    selected->setInfected(true, day);
+    return true;
+}
+
+void ReferenceTick::handleOutbreak(Pen& pen, int day) {
+    if (!pen.outbreakStarted && pen.getInfectedCount() > pen.getAnimalCount() / 2) {
+        pen.outbreakStarted = true;
+        pen.outbreakDay = day;
+    }
+}
+
+void ReferenceTick::handleDying(Pen& pen, int maxAge, int today, int& diseaseDeaths, int& oldAgeDeaths) {
+    if (!pen.outbreakStarted) return;
+    vector<AnimalPtr> survivors;
+    for (const auto& a : pen.animals) {
+        if (a->isInfected) {
+            diseaseDeaths++;
+        }
+        else if (a->getAgeDays(today) > maxAge && zooRand() % 100 < a->getAgeDays(today) - maxAge) {
+            oldAgeDeaths++;
+        }
+        else {
+            survivors.push_back(a);
+        }
+    }
+    pen.animals = survivors;
+    pen.recountSpecies();
+    if (pen.getInfectedCount() == 0) pen.outbreakStarted = false;
+}
+
+void ReferenceTick::processDebt(Zoo& z) {
+    if (z.debtDaysLeft <= 0) return;
+    double payment = min(z.dailyDebtPayment, z.debt);
+    if (z.money >= payment) {
+        z.money -= payment;
+        z.debt -= payment;
+        z.debtDaysLeft--;
+    }
+    else {
+        z.popularity -= 10;
+    }
+}
+
+void ReferenceTick::treatMostUrgent(Zoo& z, int capacity) {
+    typedef tuple<double, int, double, uint64_t> Key;
+    vector<pair<Key, AnimalPtr>> patients;
+    for (const Pen& pen : z.pens) {
+        int infected = 0;
+        for (const auto& a : pen.animals) {
+            if (a->isInfected) infected++;
+        }
+        if (infected == 0) continue;
+        double risk = pen.outbreakStarted ? 2.0 : static_cast<double>(infected) / max(pen.getAnimalCount(), 1);
+        for (const auto& a : pen.animals) {
+            if (!a->isInfected) continue;
+            patients.push_back(make_pair(Key(-risk, -(z.day - a->infectionDay), -a->price, a->pedigreeId), a));
+        }
+    }
+    sort(patients.begin(), patients.end(), [](const pair<Key, AnimalPtr>& x, const pair<Key, AnimalPtr>& y) {
+        return x.first < y.first;
+    });
+    for (int k = 0; k < capacity && k < static_cast<int>(patients.size()); ++k) {
+        patients[k].second->setInfected(false, 0);
+        patients[k].second->setDying(false);
+    }
+}
+
+map<int, int> ReferenceTick::foodByExpiry(const Zoo& z, AnimalType diet) {
+    map<int, int> lots;
+    for (const FoodLot& lot : z.food.getLots(diet)) lots[lot.expiryDay] += lot.amount;
+    return lots;
+}
+
+void ReferenceTick::storeFood(Zoo& z, AnimalType diet, const map<int, int>& lots) {
+    FoodStock stock;
+    AnimalType other = diet == HERBIVORE ? CARNIVORE : HERBIVORE;
+    for (const FoodLot& lot : z.food.getLots(other)) {
+        stock.add(other, lot.amount, lot.expiryDay - FoodStock::shelfLife(other));
+    }
+    for (const auto& lot : lots) {
+        stock.add(diet, lot.second, lot.first - FoodStock::shelfLife(diet));
+    }
+    z.food = stock;
+}
+
+int ReferenceTick::feed(map<int, int>& lots, int amount) {
+    int given = 0;
+    while (amount > 0 && !lots.empty()) {
+        int take = min(amount, lots.begin()->second);
+        lots.begin()->second -= take;
+        amount -= take;
+        given += take;
+        if (lots.begin()->second == 0) lots.erase(lots.begin());
+    }
+    return given;
+}
+
+void ReferenceTick::clean(Zoo& z) {
+    int count = z.workers.count(CLEANER);
+    vector<pair<int, int>> dirty;   // (день загрязнения, номер вольера)
+    for (size_t i = 0; i < z.pens.size(); ++i) {
+        if (!z.pens[i].isClean) dirty.push_back(make_pair(dirtySince[z.pens[i].id], static_cast<int>(i)));
+    }
+    sort(dirty.begin(), dirty.end());
+    if (z.cleaningPriority != CLEAN_OLDEST_FIRST && static_cast<int>(dirty.size()) > count) {
+        stable_sort(dirty.begin(), dirty.end(), [&z](const pair<int, int>& x, const pair<int, int>& y) {
+            const Pen& px = z.pens[x.second];
+            const Pen& py = z.pens[y.second];
+            if (z.cleaningPriority == CLEAN_MOST_ANIMALS) return px.getAnimalCount() > py.getAnimalCount();
+            return px.getInfectedCount() > py.getInfectedCount();
+        });
+    }
+    for (int k = 0; k < count && k < static_cast<int>(dirty.size()); ++k) {
+        z.pens[dirty[k].second].isClean = true;
+    }
+}
+
+AnimalPtr ReferenceTick::breed(const AnimalPtr& a1, const AnimalPtr& a2, int today) {
+    if (!a1->canReproduce(today) || !a2->canReproduce(today) || a1->gender == a2->gender) return nullptr;
+    bool hybrid = a1->species != a2->species;
+    const SpeciesInfo& sp = hybrid ? SpeciesRegistry::instance().hybridOf(*a1->species, *a2->species) : *a1->species;
+    Climate climate = a1->climate;
+    if (hybrid) climate = (zooRand() % 2 == 0) ? a1->climate : a2->climate;
+    AnimalType type = (zooRand() % 2 == 0) ? a1->type : a2->type;
+    Gender gender = (zooRand() % 2 == 0) ? MALE : FEMALE;
+    double price = (a1->price + a2->price) / 2.0 * (hybrid ? 0.8 : 1.0);
+    AnimalPtr child = make_shared<Animal>(sp, type, climate, price, gender, a1, a2, hybrid);
+    child->birthDay = today;
+    child->generation = max(a1->generation, a2->generation) + 1;
+    child->inbreeding = Animal::kinship(a1.get(), a2.get());
+    for (int l = 0; l < GENE_LOCI; ++l) {
+        child->genome.alleles[l][0] = a1->genome.alleles[l][zooRand() % 2];
+        child->genome.alleles[l][1] = a2->genome.alleles[l][zooRand() % 2];
+    }
+    return child;
+}
+
+GameStatus ReferenceTick::nextDay(Zoo& z, const vector<char>* plan) {
+    if (z.status != RUNNING) return z.status;
+    if (z.day >= z.MAX_DAYS) return z.status = VICTORY;
+    if (!z.hasDirector()) return z.status = DIRECTOR_LOST;
+
+    z.animalsBoughtToday = 0;
+    z.today = DayMetrics();
+    processDebt(z);
+
+    for (Pen& pen : z.pens) {
+        if (!pen.animals.empty() && zooRand() % 3 == 0) {
+            if (pen.isClean) dirtySince[pen.id] = z.day;
+            pen.isClean = false;
+        }
+    }
+
+    // Болезни: заражение, распространение и вспышки во всех вольерах, соседи
+    z.syncPenLinks();
+    for (size_t i = 0; i < z.pens.size(); ++i) {
+        int chance = plan ? ((*plan)[i] ? 100 : 0) : z.scenario.infectionChance;
+        infectRandomAnimal(z.pens[i], z.day, chance);
+    }
+    vector<int> frontier;
+    vector<int> infectedCounts(z.pens.size(), 0);
+    for (size_t i = 0; i < z.pens.size(); ++i) {
+        spreadDisease(z.pens[i], z.day, z.scenario.spreadCount);
+        handleOutbreak(z.pens[i], z.day);
+        if (!z.penLinks[i].empty()) {
+            infectedCounts[i] = z.pens[i].getInfectedCount();
+            if (infectedCounts[i] > 0) frontier.push_back(static_cast<int>(i));
+        }
+    }
+    for (int source : frontier) {
+        int total = z.pens[source].getAnimalCount();
+        if (total == 0) continue;
+        int chance = z.CROSS_PEN_CHANCE * infectedCounts[source] / total;
+        for (int target : z.penLinks[source]) {
+            if (zooRand() % 100 < chance) receiveInfection(z.pens[target], z.day);
+        }
+    }
+
+    int vets = z.workers.count(VET);
+    if (vets > 0) treatMostUrgent(z, vets * z.VET_DAILY_CAPACITY);
+
+    for (Pen& pen : z.pens) {
+        handleDying(pen, z.MAX_AGE, z.day + 1, z.today.deaths[DEATH_DISEASE], z.today.deaths[DEATH_OLD_AGE]);
+    }
+
+    // Кормление: испорченный корм списывается, остальной выдается с самых старых партий
+    map<int, int> lots[2] = { foodByExpiry(z, HERBIVORE), foodByExpiry(z, CARNIVORE) };
+    for (auto& byDiet : lots) {
+        while (!byDiet.empty() && byDiet.begin()->first <= z.day) byDiet.erase(byDiet.begin());
+    }
+    for (Pen& pen : z.pens) {
+        int needed = pen.getAnimalCount();
+        if (needed == 0) continue;
+        int unfed = needed - feed(lots[pen.allowedType], needed);
+        if (unfed == 0) continue;
+        binomial_distribution<int> deaths(unfed, 0.5);
+        int deadCount = deaths(zooEngine());
+        int firstUnfed = needed - unfed;
+        for (int k = 0; k < deadCount; ++k) {
+            swap(pen.animals[firstUnfed + k], pen.animals[firstUnfed + k + zooRand() % (unfed - k)]);
+        }
+        pen.animals.erase(pen.animals.begin() + firstUnfed, pen.animals.begin() + firstUnfed + deadCount);
+        pen.recountSpecies();
+        z.today.deaths[DEATH_STARVATION] += deadCount;
+    }
+    storeFood(z, HERBIVORE, lots[HERBIVORE]);
+    storeFood(z, CARNIVORE, lots[CARNIVORE]);
+
+    clean(z);
+
+    // Популярность
+    int dirtyCount = 0;
+    int totalInfected = 0;
+    for (const Pen& pen : z.pens) {
+        if (!pen.isClean) dirtyCount++;
+        totalInfected += pen.getInfectedCount();
+    }
+    z.today.infected = totalInfected;
+    if (z.visitorModel.isEnabled()) {
+        z.visitorDay = z.visitorModel.simulate(z.pens, z.popularity, static_cast<uint32_t>(zooRand()));
+        int change = static_cast<int>(lround((z.visitorDay.satisfaction - 0.8) * 25.0));
+        if (z.visitorDay.simulated == 0) change = -dirtyCount - totalInfected;
+        z.popularity = max(z.popularity + change, 0);
+    }
+    else {
+        z.popularity = max(z.popularity - dirtyCount - totalInfected + (zooRand() % 21 - 10), 0);
+    }
+
+    // Зарплаты и доход
+    z.money -= z.workers.totalSalary();
+    z.today.salary = z.workers.totalSalary();
+    if (z.visitorModel.isEnabled()) {
+        if (z.visitorDay.simulated > 0) {
+            z.money += z.visitorDay.income;
+            z.today.visitorIncome = z.visitorDay.income;
+        }
+    }
+    else if (z.totalAnimals() > 0) {
+        int income = static_cast<int>(2 * z.popularity) * z.totalAnimals();
+        z.money += income;
+        z.today.visitorIncome = income;
+    }
+
+    if (z.money < 0) {
+        z.status = BANKRUPT;
+        z.recordMetrics();
+        return z.status;
+    }
+
+    z.market.nextIssue(z.day);
+
+    z.lastCelebCount = zooRand() % 3;
+    z.lastPhotographerCount = zooRand() % 6;
+    z.popularity += z.lastCelebCount * 10 + z.lastPhotographerCount * 5;
+
+    z.recordMetrics();
+    z.events.clear();
+    z.day++;
+    return z.status;
+}
+
+bool ReferenceTick::isQuiet(const Zoo& z) {
+    if (z.status != RUNNING || z.day >= z.MAX_DAYS || !z.hasDirector()) return false;
+    if (z.visitorModel.isEnabled()) return false;
+    if (z.workers.count(CLEANER) < static_cast<int>(z.pens.size())) return false;
+    for (const Pen& pen : z.pens) {
+        if (!pen.isClean || pen.outbreakStarted) return false;
+        for (const auto& a : pen.animals) {
+            if (a->isInfected || a->isDying) return false;
+        }
+    }
+    return true;
+}
+
+int ReferenceTick::quietDays(Zoo& z, int limit) {
+    int advanced = 0;
+    while (advanced < limit) {
+        int eaters[2] = { 0, 0 };
+        for (const Pen& pen : z.pens) eaters[pen.allowedType] += pen.getAnimalCount();
+        int animals = eaters[HERBIVORE] + eaters[CARNIVORE];
+        double salary = z.workers.totalSalary();
+        double payment = z.debtDaysLeft > 0 ? min(z.dailyDebtPayment, z.debt) : 0.0;
+        if (z.money - payment - salary < 0) break;
+
+        map<int, int> lots[2] = { foodByExpiry(z, HERBIVORE), foodByExpiry(z, CARNIVORE) };
+        bool enough = true;
+        for (int diet = 0; diet < 2; ++diet) {
+            while (!lots[diet].empty() && lots[diet].begin()->first <= z.day) lots[diet].erase(lots[diet].begin());
+            int fresh = 0;
+            for (const auto& lot : lots[diet]) fresh += lot.second;
+            if (fresh < eaters[diet]) enough = false;
+        }
+        if (!enough) break;
+
+        z.animalsBoughtToday = 0;
+        z.today = DayMetrics();
+        if (z.debtDaysLeft > 0) {
+            z.money -= payment;
+            z.debt -= payment;
+            z.debtDaysLeft--;
+        }
+        for (int diet = 0; diet < 2; ++diet) {
+            feed(lots[diet], eaters[diet]);
+            storeFood(z, static_cast<AnimalType>(diet), lots[diet]);
+        }
+
+        z.popularity = max(z.popularity + (zooRand() % 21 - 10), 0);
+        z.money -= salary;
+        z.today.salary = salary;
+        if (animals > 0) {
+            z.today.visitorIncome = static_cast<int>(2 * z.popularity) * animals;
+            z.money += z.today.visitorIncome;
+        }
+        z.market.nextIssue(z.day);
+        z.lastCelebCount = zooRand() % 3;
+        z.lastPhotographerCount = zooRand() % 6;
+        z.popularity += z.lastCelebCount * 10 + z.lastPhotographerCount * 5;
+
+        z.recordMetrics();
+        z.events.clear();
+        z.day++;
+        advanced++;
+    }
+    return advanced;
+}
+
+int ReferenceTick::fastForward(Zoo& z, int maxDays) {
+    int start = z.day;
+    while (z.day - start < maxDays && !z.isOver()) {
+        if (!isQuiet(z)) {
+            nextDay(z);
+            if (z.day == start + maxDays || z.status != RUNNING) break;
+            continue;
+        }
+
+        double p = z.scenario.infectionChance / 100.0;
+        vector<int> firstInfection(z.pens.size(), INT_MAX);
+        int first = INT_MAX;
+        for (size_t i = 0; i < z.pens.size() && p > 0; ++i) {
+            if (z.pens[i].animals.empty()) continue;
+            firstInfection[i] = p >= 1.0 ? 0 : geometric_distribution<int>(p)(zooEngine());
+            first = min(first, firstInfection[i]);
+        }
+
+        int limit = min(min(maxDays - (z.day - start), z.MAX_DAYS - z.day), first);
+        int advanced = quietDays(z, limit);
+        if (z.day - start >= maxDays || z.isOver()) break;
+
+        vector<char> plan(z.pens.size(), 0);
+        for (size_t i = 0; i < z.pens.size(); ++i) plan[i] = firstInfection[i] == first ? 1 : 0;
+        nextDay(z, advanced == first ? &plan : nullptr);
+    }
+    return z.day - start;
+}
+
+bool ReferenceTick::treatAll(Zoo& z) {
+    vector<AnimalPtr> infected;
+    for (const Pen& pen : z.pens) {
+        for (const auto& a : pen.animals) {
+            if (a->isInfected) infected.push_back(a);
+        }
+    }
+    double cost = 100.0 * infected.size();
+    if (cost > z.money) return false;
+    for (const auto& a : infected) {
+        a->setInfected(false, 0);
+        a->setDying(false);
+    }
+    z.money -= cost;
+    return true;
+}
+
+unique_ptr<Zoo> ReferenceTick::copyOf(const Zoo& z) {
+    unique_ptr<Zoo> copy(new Zoo(z));
+    for (Pen& pen : copy->pens) {
+        for (AnimalPtr& a : pen.animals) a = make_shared<Animal>(*a);
+        pen.newInfections.clear();
+        pen.shareToken.reset();
+    }
+    copy->market.detach();
+    copy->eventLog = nullptr;
+    return copy;
+}
+
+namespace {
+
+typedef DifferentialHarness::Divergence Divergence;
+
+// Сравнение одного поля; при расхождении заполняет d
+template <typename T>
+bool same(const T& actual, const T& expected, const wstring& field, Divergence& d) {
+    if (actual == expected) return true;
+    wostringstream a;
+    wostringstream e;
+    a << setprecision(17) << actual;
+    e << setprecision(17) << expected;
+    d.field = field;
+    d.actual = a.str();
+    d.expected = e.str();
+    return false;
+}
+
+bool sameAnimal(const Animal& x, const Animal& y, const wstring& where, Divergence& d) {
+    if (!same(x.getSpeciesId(), y.getSpeciesId(), where + L".вид", d)) return false;
+    if (!same(static_cast<int>(x.getGender()), static_cast<int>(y.getGender()), where + L".пол", d)) return false;
+    if (!same(x.getBirthDay(), y.getBirthDay(), where + L".день рождения", d)) return false;
+    if (!same(x.getIsInfected(), y.getIsInfected(), where + L".заражено", d)) return false;
+    if (!same(x.getInfectionDay(), y.getInfectionDay(), where + L".день заражения", d)) return false;
+    if (!same(x.getIsDying(), y.getIsDying(), where + L".погибает", d)) return false;
+    if (!same(x.getWeight(), y.getWeight(), where + L".вес", d)) return false;
+    if (!same(x.getPrice(), y.getPrice(), where + L".цена", d)) return false;
+    if (!same(x.getGeneration(), y.getGeneration(), where + L".поколение", d)) return false;
+    if (!same(x.getInbreeding(), y.getInbreeding(), where + L".инбридинг", d)) return false;
+    for (int l = 0; l < GENE_LOCI; ++l) {
+        for (int c = 0; c < 2; ++c) {
+            if (!same(static_cast<int>(x.getGenome().alleles[l][c]), static_cast<int>(y.getGenome().alleles[l][c]),
+                where + L".аллель " + to_wstring(l), d)) return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+bool DifferentialHarness::sameZoo(const Zoo& x, const Zoo& y, const mt19937& ex, const mt19937& ey,
+    const wstring& prefix, Divergence& d) {
+    if (!same(x.day, y.day, prefix + L"день", d)) return false;
+    if (!same(static_cast<int>(x.status), static_cast<int>(y.status), prefix + L"состояние игры", d)) return false;
+    if (!same(x.money, y.money, prefix + L"деньги", d)) return false;
+    if (!same(x.debt, y.debt, prefix + L"долг", d)) return false;
+    if (!same(x.debtDaysLeft, y.debtDaysLeft, prefix + L"дней кредита", d)) return false;
+    if (!same(x.popularity, y.popularity, prefix + L"популярность", d)) return false;
+    for (int diet = 0; diet < 2; ++diet) {
+        if (!same(x.food.total(static_cast<AnimalType>(diet)), y.food.total(static_cast<AnimalType>(diet)),
+            prefix + L"корм." + FOOD_TYPES[diet], d)) return false;
+    }
+    for (int role = 0; role < 4; ++role) {
+        if (!same(x.workers.count(static_cast<WorkerType>(role)), y.workers.count(static_cast<WorkerType>(role)),
+            prefix + L"работники." + WORKER_TYPES[role], d)) return false;
+    }
+    for (int cause = 0; cause < 3; ++cause) {
+        if (!same(x.today.deaths[cause], y.today.deaths[cause], prefix + L"погибшие за день." + to_wstring(cause), d)) {
+            return false;
+        }
+    }
+    if (!same(x.today.visitorIncome, y.today.visitorIncome, prefix + L"доход от посетителей", d)) return false;
+    if (!same(x.today.salary, y.today.salary, prefix + L"зарплаты", d)) return false;
+    if (!same(x.today.infected, y.today.infected, prefix + L"зараженных", d)) return false;
+
+    if (!same(x.pens.size(), y.pens.size(), prefix + L"число вольеров", d)) return false;
+    for (size_t p = 0; p < x.pens.size(); ++p) {
+        const Pen& px = x.pens[p];
+        const Pen& py = y.pens[p];
+        wstring where = prefix + L"вольер " + to_wstring(p + 1);
+        if (!same(px.getIsClean(), py.getIsClean(), where + L".чистота", d)) return false;
+        if (!same(px.getOutbreakStarted(), py.getOutbreakStarted(), where + L".вспышка", d)) return false;
+        if (!same(px.getAnimalCount(), py.getAnimalCount(), where + L".животных", d)) return false;
+        for (int i = 0; i < px.getAnimalCount(); ++i) {
+            if (!sameAnimal(*px.getAnimals()[i], *py.getAnimals()[i], where + L".животное " + to_wstring(i + 1), d)) {
+                return false;
+            }
+        }
+    }
+
+    const vector<AnimalPtr>& mx = x.market.getAnimals();
+    const vector<AnimalPtr>& my = y.market.getAnimals();
+    if (!same(mx.size(), my.size(), prefix + L"рынок.животных", d)) return false;
+    for (size_t i = 0; i < mx.size(); ++i) {
+        if (!sameAnimal(*mx[i], *my[i], prefix + L"рынок.животное " + to_wstring(i + 1), d)) return false;
+    }
+
+    wostringstream sx;
+    wostringstream sy;
+    sx << ex;
+    sy << ey;
+    return same(sx.str() == sy.str(), true, prefix + L"генератор случайных чисел", d);
+}
+
+void DifferentialHarness::breedFirstPair(Zoo& z, bool reference) {
+    for (Pen& pen : z.pens) {
+        AnimalPtr male;
+        AnimalPtr female;
+        for (const auto& a : pen.getAnimals()) {
+            if (!a->canReproduce(z.day)) continue;
+            if (a->getGender() == MALE && !male) male = a;
+            if (a->getGender() == FEMALE && !female) female = a;
+        }
+        if (!male || !female || pen.getAnimalCount() >= pen.getCapacity()) continue;
+        AnimalPtr child = reference ? ReferenceTick::breed(male, female, z.day) : Animal::breed(male, female, z.day);
+        Pen* target = child ? z.findPenFor(child) : nullptr;
+        if (target) {
+            target->addAnimal(child);
+            z.genetics.record(*child);
+        }
+        return;
+    }
+}
+
+// Действия игрока в сценарии
+enum DiffAction { ACTION_NONE, ACTION_SELL, ACTION_DESTROY_PEN, ACTION_TREAT_ALL, ACTION_FORK, ACTION_FAST_FORWARD };
+
+struct DifferentialHarness::Step {
+    DiffAction action = ACTION_NONE;
+    unsigned pen = 0;           // Продажа: вольер (по модулю числа вольеров)
+    unsigned animal = 0;        // Продажа: животное (по модулю числа животных)
+    int days = 0;               // Перемотка: дней
+};
+
+DifferentialHarness::Step DifferentialHarness::pickStep(mt19937& actions) {
+    Step step;
+    unsigned roll = actions() % 100;
+    if (roll < 15) {
+        step.action = ACTION_SELL;
+        step.pen = actions();
+        step.animal = actions();
+    }
+    else if (roll < 20) {
+        step.action = ACTION_DESTROY_PEN;
+    }
+    else if (roll < 25) {
+        step.action = ACTION_TREAT_ALL;
+    }
+    else if (roll < 28) {
+        step.action = ACTION_FORK;
+    }
+    else if (roll < 33) {
+        step.action = ACTION_FAST_FORWARD;
+        step.days = 1 + actions() % 30;
+    }
+    return step;
+}
+
+void DifferentialHarness::applyStep(Zoo& z, const Step& step, bool reference) {
+    if (step.action == ACTION_SELL && !z.pens.empty()) {
+        int p = static_cast<int>(step.pen % z.pens.size());
+        if (z.pens[p].getAnimalCount() > 0) z.sellAnimal(p, static_cast<int>(step.animal % z.pens[p].getAnimalCount()));
+    }
+    else if (step.action == ACTION_DESTROY_PEN) {
+        for (size_t p = 0; p < z.pens.size(); ++p) {
+            if (z.pens[p].getAnimalCount() > 0) continue;
+            z.destroyPen(static_cast<int>(p));
+            break;
+        }
+    }
+    else if (step.action == ACTION_TREAT_ALL) {
+        if (reference) ReferenceTick::treatAll(z);
+        else z.treatAllAnimals();
+    }
+}
+
+bool DifferentialHarness::run(Divergence& d, const function<void(int, int)>& progress) const {
+    bool wasQuiet = zooQuiet();
+    zooQuiet() = true;
+    mt19937 picker(seed);
+    for (int r = 0; r < runs; ++r) {
+        // Случайный сценарий и стратегия
+        Scenario sc;
+        sc.maxDays = days;
+        sc.startMoney = 5000.0 + picker() % 45000;
+        sc.maxAge = 10 + picker() % 31;
+        sc.infectionChance = 10 + picker() % 51;
+        sc.spreadCount = 1 + picker() % 3;
+        vector<double> genes(POLICY_PARAMS.size());
+        for (double& g : genes) g = (picker() % 1001) / 1000.0;
+        Policy policy = decodePolicy(genes);
+        // Без ветеринаров зараженные доживают до следующего дня, и болезнь
+        // распространяется внутри вольеров (иначе всех лечат в день заражения)
+        if (picker() % 4 == 0) policy.vetRatio = 0.0;
+        CleaningPriority priority = static_cast<CleaningPriority>(picker() % CLEANING_PRIORITY_NAMES.size());
+        int breedEvery = 2 + picker() % 8;
+        bool linkPens = picker() % 2 == 0;
+        unsigned gameSeed = picker();
+        mt19937 actions(picker());
+
+        zooSeed(gameSeed);
+        unique_ptr<Zoo> actual(new Zoo(L"Основной", L"Директор", sc));
+        mt19937 actualEngine = zooEngine();
+        zooSeed(gameSeed);
+        unique_ptr<Zoo> expected(new Zoo(L"Эталон", L"Директор", sc));
+        mt19937 expectedEngine = zooEngine();
+        ReferenceTick tick;
+
+        // Исходные зоопарки последнего ветвления: основной делит животных с веткой
+        unique_ptr<Zoo> actualSource;
+        unique_ptr<Zoo> expectedSource;
+        mt19937 sourceEngine;
+
+        bool ok = true;
+        while (ok && (!actual->isOver() || !expected->isOver())) {
+            Step step = pickStep(actions);
+            if (step.action == ACTION_FORK) {
+                if (actualSource && !sameZoo(*actualSource, *expectedSource, sourceEngine, sourceEngine,
+                    L"исходный зоопарк: ", d)) {
+                    ok = false;
+                    break;
+                }
+                actualSource = move(actual);
+                actual.reset(new Zoo(actualSource->fork()));
+                expectedSource = move(expected);
+                expected = ReferenceTick::copyOf(*expectedSource);
+                sourceEngine = expectedEngine;
+            }
+
+            Zoo* zoos[2] = { actual.get(), expected.get() };
+            mt19937* engines[2] = { &actualEngine, &expectedEngine };
+            for (int k = 0; k < 2; ++k) {
+                Zoo& z = *zoos[k];
+                zooEngine() = *engines[k];
+                z.setCleaningPriority(priority);
+                size_t pensBefore = z.pens.size();
+                PolicyPilot::act(z, policy);
+                // Новые вольеры соединяются с предыдущим
+                for (size_t p = max<size_t>(pensBefore, 1); linkPens && p < z.pens.size(); ++p) {
+                    z.togglePenLink(static_cast<int>(p) - 1, static_cast<int>(p));
+                }
+                if (z.day % breedEvery == 0) breedFirstPair(z, k == 1);
+                applyStep(z, step, k == 1);
+                if (step.action == ACTION_FAST_FORWARD) {
+                    if (k == 0) z.fastForward(step.days);
+                    else tick.fastForward(z, step.days);
+                }
+                else {
+                    if (k == 0) z.nextDay();
+                    else tick.nextDay(z);
+                }
+                *engines[k] = zooEngine();
+            }
+            ok = sameZoo(*actual, *expected, actualEngine, expectedEngine, L"", d);
+        }
+        if (ok && actualSource) {
+            ok = sameZoo(*actualSource, *expectedSource, sourceEngine, sourceEngine, L"исходный зоопарк: ", d);
+        }
+        if (!ok) {
+            d.run = r;
+            d.day = expected->day;
+            zooQuiet() = wasQuiet;
+            return false;
+        }
+        if (progress) progress(r, actual->day);
+    }
+    zooQuiet() = wasQuiet;
+    return true;
+}
@@ -0,0 +1,108 @@
+// Эталонный дневной ход и дифференциальная проверка
+#pragma once
+
+#include "policy.h"
+
+// Эталонный ход: замороженная копия правил дня (Zoo::nextDay, Zoo::fastForward
+// и методов Pen и Animal, которые они вызывают) в простейшей записи. Эталон
+// не пользуется структурами основного хода: вместо планировщика каждый день
+// обходятся все вольеры, пациенты ветеринаров и грязные вольеры выбираются
+// полным просмотром, корм считается по дням порчи. Поэтому любая переработка
+// основного хода проверяется сравнением с этой копией (см. DifferentialHarness).
+// Копию нельзя менять вместе с основным ходом - только при намеренном
+// изменении правил игры
+class ReferenceTick {
+private:
+    map<int, int> dirtySince;   // День загрязнения по номеру вольера (Pen::getId)
+
+    static vector<AnimalPtr> healthyOf(const Pen& pen);
+
+    static bool infectRandomAnimal(Pen& pen, int day, int chance);
+
+    static void spreadDisease(Pen& pen, int day, int spreadCount);
+
+    static bool receiveInfection(Pen& pen, int day);
+
+    static void handleOutbreak(Pen& pen, int day);
+
+    static void handleDying(Pen& pen, int maxAge, int today, int& diseaseDeaths, int& oldAgeDeaths);
+
+    static void processDebt(Zoo& z);
+
+    // Лечение до capacity самых срочных зараженных
+    static void treatMostUrgent(Zoo& z, int capacity);
+
+    // Корм вида по дням порчи и запись обратно на склад
+    static map<int, int> foodByExpiry(const Zoo& z, AnimalType diet);
+    static void storeFood(Zoo& z, AnimalType diet, const map<int, int>& lots);
+
+    // Выдача до amount корма с самых старых партий, возвращает выданное
+    static int feed(map<int, int>& lots, int amount);
+
+    // Уборка вольеров по правилам DirtyPenQueue::take
+    void clean(Zoo& z);
+
+    // Спокойное состояние по правилам Zoo::isQuiet
+    static bool isQuiet(const Zoo& z);
+
+    // Спокойные дни по правилам Zoo::advanceQuietDays
+    static int quietDays(Zoo& z, int limit);
+
+public:
+    // Размножение по правилам Animal::breed
+    static AnimalPtr breed(const AnimalPtr& a1, const AnimalPtr& a2, int today);
+
+    // Ход по правилам Zoo::nextDay; plan - заражения дня перемотки (Zoo::infectionPlan)
+    GameStatus nextDay(Zoo& z, const vector<char>* plan = nullptr);
+
+    // Перемотка по правилам Zoo::fastForward
+    int fastForward(Zoo& z, int maxDays);
+
+    // Лечение всех зараженных по правилам Zoo::treatAllAnimals
+    static bool treatAll(Zoo& z);
+
+    // Полная копия зоопарка со своими животными (ветка без общих вольеров)
+    static unique_ptr<Zoo> copyOf(const Zoo& z);
+};
+
+// Дифференциальная проверка: основной ход (Zoo::nextDay) и эталонный
+// (ReferenceTick) играют одни и те же случайные сценарии с одного зерна,
+// каждый со своим генератором. Кроме автопилота, в сценарий случайно
+// попадают продажа, снос пустого вольера, лечение всех, перемотка и ветвление
+// (основной зоопарк ветвится через Zoo::fork, эталон копируется целиком; при
+// следующем ветвлении и в конце сценария сравниваются и исходные зоопарки).
+// После каждого дня сравнивается наблюдаемое состояние обоих зоопарков,
+// включая состояние генератора; первое расхождение возвращается с названием поля
+class DifferentialHarness {
+public:
+    int runs = 20;              // Случайных сценариев
+    int days = 1000;            // Дней в сценарии
+    unsigned seed = 1;          // Зерно выбора сценариев
+
+    // Найденное расхождение
+    struct Divergence {
+        int run = -1;
+        int day = -1;
+        wstring field;
+        wstring expected;       // Значение эталонного хода
+        wstring actual;         // Значение основного хода
+    };
+
+    // Проверка; progress вызывается после каждого сценария
+    bool run(Divergence& d, const function<void(int, int)>& progress) const;
+
+private:
+    // Действие игрока перед ходом, общее для обоих движков
+    struct Step;
+
+    static Step pickStep(mt19937& actions);
+
+    static void applyStep(Zoo& z, const Step& step, bool reference);
+
+    // Скрещивание первой подходящей пары в первом вольере, где она есть
+    static void breedFirstPair(Zoo& z, bool reference);
+
+    // Сравнение наблюдаемого состояния; prefix добавляется к названию поля
+    static bool sameZoo(const Zoo& x, const Zoo& y, const mt19937& ex, const mt19937& ey,
+        const wstring& prefix, Divergence& d);
+};
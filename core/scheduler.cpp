@@ -0,0 +1,30 @@
+// Планировщик событий по дням
+#include "scheduler.h"
+
+bool ScheduledEvent::operator>(const ScheduledEvent& other) const {
+    if (day != other.day) return day > other.day;
+    if (kind != other.kind) return kind > other.kind;
+    return target > other.target;
+}
+
+bool DayScheduler::popDue(int currentDay, ScheduledEvent& out) {
+    if (queue.empty() || queue.top().day > currentDay) return false;
+    out = queue.top();
+    queue.pop();
+    return true;
+}
+
+void DayScheduler::removePen(int index) {
+    vector<ScheduledEvent> kept;
+    kept.reserve(queue.size());
+    while (!queue.empty()) {
+        ScheduledEvent e = queue.top();
+        queue.pop();
+        if (e.kind == EVENT_PEN_DISEASE) {
+            if (e.target == index) continue;
+            if (e.target > index) e.target--;
+        }
+        kept.push_back(e);
+    }
+    for (const auto& e : kept) queue.push(e);
+}
@@ -0,0 +1,44 @@
+// Планировщик событий по дням
+#pragma once
+
+#include "common.h"
+
+// Виды запланированных событий
+enum ScheduledEventKind { EVENT_LOAN_PAYMENT, EVENT_PEN_DISEASE };
+
+// Запланированное событие: день, вид и цель (номер вольера, -1 для зоопарка)
+struct ScheduledEvent {
+    int day;
+    ScheduledEventKind kind;
+    int target;
+
+    bool operator>(const ScheduledEvent& other) const;
+};
+
+// Планировщик событий по дням (очередь с приоритетом по дню).
+// Объекты регистрируют ближайший день, когда с ними что-то может произойти,
+// и ход обрабатывает только наступившие события
+class DayScheduler {
+private:
+    priority_queue<ScheduledEvent, vector<ScheduledEvent>, greater<ScheduledEvent>> queue;
+
+public:
+    // Регистрация события
+    void schedule(int day, ScheduledEventKind kind, int target = -1) {
+        ScheduledEvent e = { day, kind, target };
+        queue.push(e);
+    }
+
+    // Извлечение следующего наступившего события (false, если таких нет)
+    bool popDue(int currentDay, ScheduledEvent& out);
+
+    // День ближайшего события (INT_MAX, если событий нет)
+    int nextDay() const {
+        return queue.empty() ? INT_MAX : queue.top().day;
+    }
+
+    // Удаление событий вольера и сдвиг номеров следующих вольеров
+    void removePen(int index);
+
+    size_t size() const { return queue.size(); }
+};
@@ -0,0 +1,68 @@
+// Персонал зоопарка
+#include "staff.h"
+
+double Worker::baseSalary(WorkerType t) {
+    switch (t) {
+    case VET: return 50.0;
+    case CLEANER: return 20.0;
+    case FEEDER: return 30.0;
+    case DIRECTOR: return 500.0;
+    }
+    return 0.0;
+}
+
+bool WorkerRoster::locate(int index, int& role, int& pos) const {
+    if (index < 0 || index >= total) return false;
+    for (role = 0; role < ROLE_COUNT; ++role) {
+        int size = static_cast<int>(byRole[role].size());
+        if (index < size) {
+            pos = index;
+            return true;
+        }
+        index -= size;
+    }
+    return false;
+}
+
+void WorkerRoster::hire(WorkerType type, const wstring& name) {
+    byRole[type].emplace_back(type, name, rates[type]);
+    int64_t cents = toCents(byRole[type].back().salary);
+    payroll[type] += cents;
+    totalPayroll += cents;
+    total++;
+}
+
+bool WorkerRoster::fire(int index, Worker& fired) {
+    int role;
+    int pos;
+    if (!locate(index, role, pos)) return false;
+    vector<Worker>& bucket = byRole[role];
+    fired = bucket[pos];
+    int64_t cents = toCents(fired.salary);
+    payroll[role] -= cents;
+    totalPayroll -= cents;
+    if (pos != static_cast<int>(bucket.size()) - 1) {
+        bucket[pos] = bucket.back();
+    }
+    bucket.pop_back();
+    total--;
+    return true;
+}
+
+Worker& WorkerRoster::operator[](size_t index) {
+    int role = 0;
+    int pos = 0;
+    if (index > static_cast<size_t>(INT_MAX) || !locate(static_cast<int>(index), role, pos)) {
+        throw out_of_range("WorkerRoster::operator[]");
+    }
+    return byRole[role][pos];
+}
+
+const Worker& WorkerRoster::operator[](size_t index) const {
+    int role = 0;
+    int pos = 0;
+    if (index > static_cast<size_t>(INT_MAX) || !locate(static_cast<int>(index), role, pos)) {
+        throw out_of_range("WorkerRoster::operator[]");
+    }
+    return byRole[role][pos];
+}
@@ -0,0 +1,72 @@
+// Персонал зоопарка
+#pragma once
+
+#include "common.h"
+
+// Структура, представляющая работника зоопарка
+struct Worker {
+    WorkerType type;    // Тип работника
+    wstring name;       // Имя работника
+    double salary;      // Зарплата
+
+    // Конструктор работника
+    Worker(WorkerType t, wstring n) : type(t), name(n), salary(baseSalary(t)) {}
+
+    // Конструктор работника с зарплатой сценария
+    Worker(WorkerType t, wstring n, double s) : type(t), name(n), salary(s) {}
+
+    // Зарплата в зависимости от типа
+    static double baseSalary(WorkerType t);
+
+    // Получение названия типа работника
+    wstring getTypeName() const {
+        return WORKER_TYPES[static_cast<int>(type)];
+    }
+};
+
+// Штат зоопарка, разложенный по должностям. Количество работников каждой
+// должности и фонд зарплаты поддерживаются при найме и увольнении, поэтому
+// проверки штата и расчет зарплаты выполняются за O(1). Фонд ведется в целых
+// центах: сумма double после тысяч наймов и увольнений накапливала бы ошибку.
+// Сквозная нумерация идет по должностям: ветеринары, уборщики, кормильщики, директор
+class WorkerRoster {
+private:
+    static const int ROLE_COUNT = 4;
+    vector<Worker> byRole[ROLE_COUNT]; // Работники по должностям
+    int64_t payroll[ROLE_COUNT] = {};  // Фонд зарплаты по должностям, в центах
+    int64_t totalPayroll = 0;          // Общий фонд зарплаты, в центах
+    int total = 0;                     // Всего работников
+    double rates[ROLE_COUNT] = {       // Зарплата новых работников по должностям
+        Worker::baseSalary(VET), Worker::baseSalary(CLEANER),
+        Worker::baseSalary(FEEDER), Worker::baseSalary(DIRECTOR) };
+
+    // Перевод сквозного номера в (должность, номер в должности)
+    bool locate(int index, int& role, int& pos) const;
+
+    // Зарплата в центах
+    static int64_t toCents(double salary) { return llround(salary * 100.0); }
+
+public:
+    // Наем работника
+    void hire(WorkerType type, const wstring& name);
+
+    // Увольнение по сквозному номеру (последний работник должности занимает место уволенного)
+    bool fire(int index, Worker& fired);
+
+    // Зарплата, с которой нанимаются новые работники должности
+    void setRate(WorkerType type, double salary) { rates[type] = salary; }
+
+    // Доступ по сквозному номеру (out_of_range при неверном номере)
+    Worker& operator[](size_t index);
+    const Worker& operator[](size_t index) const;
+
+    // Работники одной должности
+    const vector<Worker>& ofRole(WorkerType type) const { return byRole[type]; }
+
+    // Счетчики и зарплаты
+    size_t size() const { return total; }
+    bool empty() const { return total == 0; }
+    int count(WorkerType type) const { return static_cast<int>(byRole[type].size()); }
+    double salaryOf(WorkerType type) const { return payroll[type] / 100.0; }
+    double totalSalary() const { return totalPayroll / 100.0; }
+};
@@ -0,0 +1,168 @@
+// Перебор сценариев по сетке с кэшем результатов
+#include "sweep.h"
+
+// Хеш исходников ядра, вычисляется CMake при конфигурации
+#ifndef ZOO_ENGINE_HASH
+#define ZOO_ENGINE_HASH 0
+#endif
+
+uint64_t SweepRunner::runKey(const Scenario& sc) {
+    return (sc.hash() * 31 + ENGINE_VERSION) * 1099511628211ull ^ static_cast<uint64_t>(ZOO_ENGINE_HASH);
+}
+
+bool SweepRunner::parse(const wstring& spec, wstring& error) {
+    axes.clear();
+    wstringstream axesStream(spec);
+    wstring axisSpec;
+    while (getline(axesStream, axisSpec, L';')) {
+        if (axisSpec.empty()) continue;
+        size_t eq = axisSpec.find(L'=');
+        if (eq == wstring::npos) {
+            error = L"нет '=' в \"" + axisSpec + L"\"";
+            return false;
+        }
+        SweepAxis axis;
+        axis.name = axisSpec.substr(0, eq);
+        wstring values = axisSpec.substr(eq + 1);
+        Scenario probe;
+        if (!setScenarioParam(probe, axis.name, 0.0)) {
+            error = L"неизвестный параметр " + axis.name;
+            return false;
+        }
+        try {
+            if (count(values.begin(), values.end(), L':') == 2) {
+                size_t c1 = values.find(L':');
+                size_t c2 = values.find(L':', c1 + 1);
+                double from = stod(values.substr(0, c1));
+                double to = stod(values.substr(c1 + 1, c2 - c1 - 1));
+                double step = stod(values.substr(c2 + 1));
+                if (step <= 0) {
+                    error = L"шаг должен быть положительным: " + axis.name;
+                    return false;
+                }
+                for (int k = 0; from + k * step <= to + step * 1e-9; ++k) axis.values.push_back(from + k * step);
+            }
+            else {
+                wstringstream valueStream(values);
+                wstring v;
+                while (getline(valueStream, v, L',')) axis.values.push_back(stod(v));
+            }
+        }
+        catch (...) {
+            error = L"неверные значения: " + axisSpec;
+            return false;
+        }
+        if (axis.values.empty()) {
+            error = L"нет значений: " + axis.name;
+            return false;
+        }
+        axes.push_back(axis);
+    }
+    if (axes.empty()) {
+        error = L"пустая сетка";
+        return false;
+    }
+    return true;
+}
+
+void SweepRunner::loadCache(const string& path) {
+    cachePath = path;
+    cache.clear();
+    ifstream in(path);
+    string hex;
+    unsigned seed;
+    int status;
+    RolloutResult r;
+    while (in >> hex >> seed >> status >> r.days >> r.netWorth) {
+        r.status = static_cast<GameStatus>(status);
+        cache[make_pair(stoull(hex, nullptr, 16), seed)] = r;
+    }
+}
+
+size_t SweepRunner::points() const {
+    size_t total = 1;
+    for (const SweepAxis& axis : axes) total *= axis.values.size();
+    return total;
+}
+
+Scenario SweepRunner::scenarioAt(size_t point, vector<double>& values) const {
+    Scenario sc;
+    values.assign(axes.size(), 0.0);
+    for (size_t a = axes.size(); a-- > 0;) {
+        const SweepAxis& axis = axes[a];
+        values[a] = axis.values[point % axis.values.size()];
+        setScenarioParam(sc, axis.name, values[a]);
+        point /= axis.values.size();
+    }
+    return sc;
+}
+
+bool SweepRunner::run(const string& csvPath) {
+    size_t total = points();
+    vector<Scenario> scenarios(total);
+    vector<vector<double>> values(total);
+    for (size_t p = 0; p < total; ++p) scenarios[p] = scenarioAt(p, values[p]);
+
+    // Недостающие пары (точка, зерно); одинаковые сценарии считаются один раз
+    vector<pair<size_t, unsigned>> jobs;
+    set<pair<uint64_t, unsigned>> queued;
+    for (size_t p = 0; p < total; ++p) {
+        for (int s = 1; s <= seeds; ++s) {
+            auto key = make_pair(runKey(scenarios[p]), static_cast<unsigned>(s));
+            if (cache.count(key) == 0 && queued.insert(key).second) jobs.emplace_back(p, s);
+        }
+    }
+    reused = static_cast<int>(total * seeds - jobs.size());
+    computed = static_cast<int>(jobs.size());
+
+    vector<RolloutResult> results(jobs.size());
+    Policy policy;
+    parallelFor(static_cast<int>(jobs.size()), threads, [&](int j) {
+        results[j] = runRollout(policy, jobs[j].second, scenarios[jobs[j].first]);
+    });
+
+    ofstream cacheOut(cachePath, ios::app);
+    for (size_t j = 0; j < jobs.size(); ++j) {
+        auto key = make_pair(runKey(scenarios[jobs[j].first]), jobs[j].second);
+        cache[key] = results[j];
+        cacheOut << hex << key.first << dec << ' ' << key.second << ' ' << static_cast<int>(results[j].status)
+            << ' ' << results[j].days << ' ' << setprecision(17) << results[j].netWorth << '\n';
+    }
+
+    ofstream csv(csvPath);
+    if (!csv) return false;
+    for (const SweepAxis& axis : axes) csv << toUtf8(axis.name) << ',';
+    csv << "runs,mean_net_worth,bankrupt_share,mean_days\n";
+    for (size_t p = 0; p < total; ++p) {
+        double worth = 0.0;
+        double days = 0.0;
+        int bankrupt = 0;
+        for (int s = 1; s <= seeds; ++s) {
+            const RolloutResult& r = cache[make_pair(runKey(scenarios[p]), static_cast<unsigned>(s))];
+            worth += r.netWorth;
+            days += r.days;
+            if (r.status == BANKRUPT) bankrupt++;
+        }
+        for (double v : values[p]) csv << v << ',';
+        csv << seeds << ',' << fixed << setprecision(2) << worth / seeds << ','
+            << static_cast<double>(bankrupt) / seeds << ',' << days / seeds << '\n';
+        csv.unsetf(ios::fixed);
+        csv << setprecision(6);
+    }
+    return true;
+}
+
+bool setScenarioParam(Scenario& sc, const wstring& name, double value) {
+    if (name == L"money") sc.startMoney = value;
+    else if (name == L"maxAge") sc.maxAge = static_cast<int>(lround(value));
+    else if (name == L"infection") sc.infectionChance = static_cast<int>(lround(value));
+    else if (name == L"spread") sc.spreadCount = static_cast<int>(lround(value));
+    else if (name == L"interest") sc.loanInterest = value;
+    else if (name == L"vetSalary") sc.salaries[VET] = value;
+    else if (name == L"cleanerSalary") sc.salaries[CLEANER] = value;
+    else if (name == L"feederSalary") sc.salaries[FEEDER] = value;
+    else if (name == L"directorSalary") sc.salaries[DIRECTOR] = value;
+    else if (name == L"days") sc.maxDays = max(static_cast<int>(lround(value)), 1);
+    else return false;
+    return true;
+}
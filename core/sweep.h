@@ -0,0 +1,55 @@
+// Перебор сценариев по сетке с кэшем результатов
+#pragma once
+
+#include "policy.h"
+
+// Ось сетки перебора: параметр сценария и его значения
+struct SweepAxis {
+    wstring name;
+    vector<double> values;
+};
+
+// Установка параметра сценария по имени (false - неизвестный параметр)
+bool setScenarioParam(Scenario& sc, const wstring& name, double value);
+
+// Перебор сценариев по сетке с кэшем результатов на диске. Результат прогона
+// хранится по ключу (хеш сценария, зерно), поэтому повторный перебор
+// пересекающейся сетки считает только новые точки
+class SweepRunner {
+public:
+    // Версия правил игры в ключе кэша: при изменении логики хода ее нужно
+    // увеличить, чтобы старые результаты не использовались. Сборка CMake
+    // дополнительно подмешивает в ключ хеш исходников ядра (ZOO_ENGINE_HASH),
+    // так что забытое увеличение версии не отдаст устаревший результат
+    static const int ENGINE_VERSION = 5;
+
+private:
+    vector<SweepAxis> axes;
+    map<pair<uint64_t, unsigned>, RolloutResult> cache;
+    string cachePath;
+
+    static uint64_t runKey(const Scenario& sc);
+
+public:
+    int seeds = 4;              // Прогонов (зерна 1..seeds) на точку
+    int threads = 1;            // Потоков
+    int computed = 0;           // Посчитано в последнем переборе
+    int reused = 0;             // Взято из кэша в последнем переборе
+
+    // Разбор сетки "имя=a,b,c;имя=от:до:шаг"
+    bool parse(const wstring& spec, wstring& error);
+
+    // Загрузка кэша (строки: хеш зерно состояние дни итог)
+    void loadCache(const string& path);
+
+    size_t points() const;
+
+    const vector<SweepAxis>& getAxes() const { return axes; }
+
+    // Сценарий точки сетки по ее номеру
+    Scenario scenarioAt(size_t point, vector<double>& values) const;
+
+    // Перебор: недостающие прогоны считаются параллельно и дописываются в кэш,
+    // итог по точкам пишется в CSV
+    bool run(const string& csvPath);
+};
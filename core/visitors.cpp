@@ -0,0 +1,164 @@
+// Агентная модель посетителей
+#include "visitors.h"
+
+uint32_t VisitorModel::mix(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    uint32_t r = static_cast<uint32_t>(x ^ (x >> 31));
+    return r == 0 ? 1u : r;
+}
+
+vector<VisitorModel::PenAppeal> VisitorModel::rateZoo(const vector<Pen>& pens) {
+    vector<PenAppeal> appeal(pens.size());
+    int occupied = 0;
+    for (const Pen& pen : pens) {
+        if (pen.getAnimalCount() > 0) occupied++;
+    }
+    // Нормировка: в чистом зоопарке без толпы с одинаковыми вольерами
+    // выручка совпадает с прежней формулой 2 * популярность * животные
+    double valuePerAnimal = 2.0 * occupied / (VISITORS_PER_POPULARITY * STEPS_PER_DAY);
+    for (size_t p = 0; p < pens.size(); ++p) {
+        const Pen& pen = pens[p];
+        int count = pen.getAnimalCount();
+        if (count == 0) continue;
+        unordered_set<int> species;
+        int hybrids = 0;
+        for (const auto& a : pen.getAnimals()) {
+            species.insert(a->getSpeciesId());
+            if (a->getIsHybrid()) hybrids++;
+        }
+        float quality = pen.getIsClean() ? 1.0f : 0.6f;
+        quality *= 1.0f - 0.5f * pen.getInfectedCount() / count;
+        appeal[p].quality = quality;
+        appeal[p].weight = (count + 2.0f * species.size() + 3.0f * hybrids) * quality;
+        appeal[p].comfort = static_cast<float>(max(pen.getCapacity(), 1) * VIEWERS_PER_PLACE);
+        appeal[p].value = static_cast<float>(count * valuePerAnimal);
+    }
+    return appeal;
+}
+
+void VisitorModel::buildChoiceTable(const vector<float>& weights, vector<int32_t>& table) {
+    const int slots = 1 << CHOICE_BITS;
+    double total = 0.0;
+    for (float w : weights) total += w;
+    size_t p = 0;
+    double cumulative = weights.empty() ? 0.0 : weights[0];
+    for (int s = 0; s < slots; ++s) {
+        double target = (s + 0.5) * total / slots;
+        while (p + 1 < weights.size() && cumulative <= target) cumulative += weights[++p];
+        table[s] = static_cast<int32_t>(p);
+    }
+}
+
+void VisitorModel::runBlock(int first, int last, const vector<PenAppeal>& appeal, double crowdScale,
+    uint32_t seed, BlockResult& result) {
+    const size_t penCount = appeal.size();
+    vector<float> weights(penCount);
+    vector<float> quality(penCount);
+    vector<int32_t> table(1 << CHOICE_BITS);
+    vector<int> counts(penCount, 0);
+    result.views.assign(penCount, 0);
+
+    uint32_t* rng = rngState.data();
+    int32_t* pos = position.data();
+    float* sat = satisfaction.data();
+    for (int i = first; i < last; ++i) {
+        rng[i] = mix((static_cast<uint64_t>(seed) << 32) | static_cast<uint32_t>(i - first));
+        sat[i] = 0.0f;
+    }
+
+    for (int step = 0; step < STEPS_PER_DAY; ++step) {
+        // Выбор вольера учитывает толпу предыдущего шага
+        for (size_t p = 0; p < penCount; ++p) {
+            float crowd = static_cast<float>(counts[p] * crowdScale);
+            weights[p] = appeal[p].weight / (1.0f + crowd / appeal[p].comfort);
+        }
+        buildChoiceTable(weights, table);
+
+        // Перемещение: только арифметика над столбцами, без ветвлений
+        const int32_t* choice = table.data();
+        for (int i = first; i < last; ++i) {
+            uint32_t x = rng[i];
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            rng[i] = x;
+            pos[i] = choice[x >> (32 - CHOICE_BITS)];
+        }
+
+        fill(counts.begin(), counts.end(), 0);
+        for (int i = first; i < last; ++i) counts[pos[i]]++;
+
+        // Качество осмотра падает, когда толпа превышает комфортную
+        for (size_t p = 0; p < penCount; ++p) {
+            float crowd = static_cast<float>(counts[p] * crowdScale);
+            quality[p] = appeal[p].quality * min(1.0f, appeal[p].comfort / max(crowd, 1.0f));
+            result.income += counts[p] * static_cast<double>(quality[p]) * appeal[p].value;
+            result.views[p] += counts[p];
+        }
+
+        const float* q = quality.data();
+        for (int i = first; i < last; ++i) sat[i] += q[pos[i]];
+    }
+
+    for (int i = first; i < last; ++i) result.satisfaction += sat[i] / STEPS_PER_DAY;
+}
+
+VisitorDayResult VisitorModel::simulate(const vector<Pen>& pens, int popularity, uint32_t seed) {
+    VisitorDayResult day;
+    day.penViews.assign(pens.size(), 0);
+    vector<PenAppeal> appeal = rateZoo(pens);
+    double totalWeight = 0.0;
+    for (const PenAppeal& a : appeal) totalWeight += a.weight;
+
+    // Без животных смотреть не на что: посетители не приходят
+    if (totalWeight <= 0.0) return day;
+    day.visitors = max(popularity, 0) * VISITORS_PER_POPULARITY;
+    day.simulated = min(day.visitors, maxVisitors);
+    if (day.simulated == 0) return day;
+
+    if (static_cast<int>(rngState.size()) < day.simulated) {
+        rngState.resize(day.simulated);
+        position.resize(day.simulated);
+        satisfaction.resize(day.simulated);
+    }
+
+    int blocks = (day.simulated + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    vector<BlockResult> results(blocks);
+    double sampleScale = static_cast<double>(day.visitors) / day.simulated;
+    auto runRange = [&](int block) {
+        int first = block * BLOCK_SIZE;
+        int last = min(first + BLOCK_SIZE, day.simulated);
+        // Блок представляет свою долю всех пришедших посетителей
+        double crowdScale = static_cast<double>(day.visitors) / (last - first);
+        runBlock(first, last, appeal, crowdScale, mix(seed + static_cast<uint64_t>(block)), results[block]);
+    };
+
+    int workers = min(threadCount, blocks);
+    if (workers <= 1) {
+        for (int b = 0; b < blocks; ++b) runRange(b);
+    }
+    else {
+        atomic<int> nextBlock(0);
+        vector<thread> pool;
+        for (int t = 0; t < workers; ++t) {
+            pool.emplace_back([&]() {
+                for (int b = nextBlock++; b < blocks; b = nextBlock++) runRange(b);
+            });
+        }
+        for (thread& t : pool) t.join();
+    }
+
+    // Сведение блоков по порядку: сумма не зависит от числа потоков
+    double income = 0.0;
+    double satisfactionSum = 0.0;
+    for (const BlockResult& r : results) {
+        income += r.income;
+        satisfactionSum += r.satisfaction;
+        for (size_t p = 0; p < r.views.size(); ++p) day.penViews[p] += r.views[p];
+    }
+    day.income = income * sampleScale;
+    day.satisfaction = satisfactionSum / day.simulated;
+    return day;
+}
@@ -0,0 +1,78 @@
+// Агентная модель посетителей
+#pragma once
+
+#include "pen.h"
+
+// Итоги дня модели посетителей
+struct VisitorDayResult {
+    int visitors = 0;           // Пришедших посетителей
+    int simulated = 0;          // Из них смоделировано поименно
+    double income = 0.0;        // Выручка от осмотра вольеров
+    double satisfaction = 0.0;  // Средняя удовлетворенность (0..1)
+    vector<int> penViews;       // Просмотры каждого вольера (в смоделированных посетителях)
+};
+
+// Агентная модель посетителей. Каждый посетитель за день осматривает
+// STEPS_PER_DAY вольеров, выбирая следующий по привлекательности (число и
+// разнообразие животных, гибриды, чистота, зараженные) с поправкой на толпу.
+// Состояние посетителей хранится по столбцам и обрабатывается блоками
+// BLOCK_SIZE: блок - единица работы потока со своим генератором, поэтому
+// результат не зависит от числа потоков. Толпа у вольера оценивается по
+// блоку, умноженному на долю блока среди всех посетителей.
+class VisitorModel {
+public:
+    static const int STEPS_PER_DAY = 8;          // Вольеров за визит
+    static const int BLOCK_SIZE = 4096;          // Посетителей в блоке
+    static const int CHOICE_BITS = 12;           // Таблица выбора вольера на 4096 ячеек
+    static const int VISITORS_PER_POPULARITY = 100; // Посетителей на единицу популярности
+    static const int VIEWERS_PER_PLACE = 500;    // Комфортная толпа на место в вольере
+
+private:
+    int maxVisitors = 0;        // Предел поименно моделируемых посетителей (0 - модель выключена)
+    int threadCount = 1;        // Число потоков
+    // Состояние посетителей по столбцам
+    vector<uint32_t> rngState;  // Генератор xorshift32 каждого посетителя
+    vector<int32_t> position;   // Текущий вольер
+    vector<float> satisfaction; // Накопленное качество осмотров
+
+    // Оценка вольеров на день
+    struct PenAppeal {
+        float weight = 0.0f;    // Привлекательность при выборе
+        float quality = 0.0f;   // Качество осмотра без учета толпы
+        float comfort = 1.0f;   // Комфортная толпа
+        float value = 0.0f;     // Выручка за осмотр при качестве 1
+    };
+
+    // Итоги одного блока
+    struct BlockResult {
+        double income = 0.0;
+        double satisfaction = 0.0;
+        vector<int> views;
+    };
+
+    static uint32_t mix(uint64_t x);
+
+    static vector<PenAppeal> rateZoo(const vector<Pen>& pens);
+
+    // Таблица выбора: ячейка -> вольер, доли ячеек пропорциональны весам
+    static void buildChoiceTable(const vector<float>& weights, vector<int32_t>& table);
+
+    // Обход дня для посетителей [first, last)
+    void runBlock(int first, int last, const vector<PenAppeal>& appeal, double crowdScale,
+        uint32_t seed, BlockResult& result);
+
+public:
+    // Включение модели: предел поименно моделируемых посетителей и число потоков
+    void enable(int maxSimulated, int threads) {
+        maxVisitors = max(maxSimulated, 0);
+        threadCount = max(threads, 1);
+    }
+
+    bool isEnabled() const { return maxVisitors > 0; }
+    int getMaxVisitors() const { return maxVisitors; }
+    int getThreadCount() const { return threadCount; }
+
+    // Моделирование дня. Если посетителей больше предела, моделируется выборка,
+    // а выручка масштабируется на всех пришедших
+    VisitorDayResult simulate(const vector<Pen>& pens, int popularity, uint32_t seed);
+};
@@ -0,0 +1,258 @@
+// Мир из многих зоопарков с общей биржей животных
+#include "world.h"
+
+TradeBook::TradeBook(int shardCount) {
+    for (int s = 0; s < max(shardCount, 1); ++s) shards.emplace_back(new Shard());
+}
+
+void TradeBook::post(TradeAsk ask) {
+    Shard& shard = shardOf(ask.animal->getSpeciesId());
+    lock_guard<mutex> guard(shard.lock);
+    shard.asks.push_back(move(ask));
+}
+
+void TradeBook::post(TradeBid bid) {
+    Shard& shard = shardOf(bid.speciesId);
+    lock_guard<mutex> guard(shard.lock);
+    shard.bids.push_back(bid);
+}
+
+void TradeBook::match(int day, int threads, const function<void(int, const TradeFill&)>& deliver) {
+    parallelFor(static_cast<int>(shards.size()), threads, [&](int s) {
+        matchShard(*shards[s], day, deliver);
+    });
+}
+
+void TradeBook::matchShard(Shard& shard, int day, const function<void(int, const TradeFill&)>& deliver) {
+    lock_guard<mutex> guard(shard.lock);
+    vector<TradeAsk>& asks = shard.asks;
+    vector<TradeBid>& bids = shard.bids;
+    // Продажи: по виду, затем дешевле и раньше; покупки: по виду, затем дороже и раньше
+    sort(asks.begin(), asks.end(), [](const TradeAsk& a, const TradeAsk& b) {
+        return make_tuple(a.animal->getSpeciesId(), a.price, a.order) <
+            make_tuple(b.animal->getSpeciesId(), b.price, b.order);
+    });
+    sort(bids.begin(), bids.end(), [](const TradeBid& a, const TradeBid& b) {
+        return make_tuple(a.speciesId, -a.maxPrice, a.order) < make_tuple(b.speciesId, -b.maxPrice, b.order);
+    });
+
+    vector<bool> taken(asks.size(), false);
+    for (const TradeBid& bid : bids) {
+        auto first = lower_bound(asks.begin(), asks.end(), bid.speciesId, [](const TradeAsk& a, int species) {
+            return a.animal->getSpeciesId() < species;
+        });
+        bool filled = false;
+        for (size_t k = first - asks.begin(); k < asks.size(); ++k) {
+            const TradeAsk& ask = asks[k];
+            if (ask.animal->getSpeciesId() != bid.speciesId || ask.price > bid.maxPrice) break;
+            if (taken[k] || ask.seller == bid.buyer) continue;
+            if (bid.gender >= 0 && ask.animal->getGender() != bid.gender) continue;
+
+            taken[k] = true;
+            TradeFill bought;
+            bought.kind = TradeFill::BOUGHT;
+            bought.order = bid.order;
+            bought.animal = ask.animal;
+            bought.amount = bid.maxPrice - ask.price;
+            deliver(bid.buyer, bought);
+            TradeFill sold;
+            sold.kind = TradeFill::SOLD;
+            sold.order = ask.order;
+            sold.amount = ask.price;
+            sold.speciesId = bid.speciesId;
+            deliver(ask.seller, sold);
+            shard.trades++;
+            shard.volume += ask.price;
+            filled = true;
+            break;
+        }
+        if (!filled) {
+            TradeFill refund;
+            refund.kind = TradeFill::REFUND;
+            refund.order = bid.order;
+            refund.amount = bid.maxPrice;
+            deliver(bid.buyer, refund);
+        }
+    }
+    bids.clear();
+
+    // Проданные снимаются, просроченные возвращаются продавцам
+    size_t kept = 0;
+    for (size_t k = 0; k < asks.size(); ++k) {
+        if (taken[k]) continue;
+        if (day - asks[k].listedDay >= LISTING_DAYS) {
+            TradeFill returned;
+            returned.kind = TradeFill::RETURNED;
+            returned.order = asks[k].order;
+            returned.animal = asks[k].animal;
+            deliver(asks[k].seller, returned);
+            continue;
+        }
+        if (kept != k) asks[kept] = move(asks[k]);
+        kept++;
+    }
+    asks.resize(kept);
+}
+
+long long TradeBook::getTrades() const {
+    long long total = 0;
+    for (const auto& shard : shards) total += shard->trades;
+    return total;
+}
+
+double TradeBook::getVolume() const {
+    double total = 0.0;
+    for (const auto& shard : shards) total += shard->volume;
+    return total;
+}
+
+size_t TradeBook::getOpenAsks() const {
+    size_t total = 0;
+    for (const auto& shard : shards) total += shard->asks.size();
+    return total;
+}
+
+World::World(int zooCount, unsigned seed, const Scenario& scenario, const Policy& policy) : policy(policy) {
+    mt19937 saved = zooEngine();
+    for (int i = 0; i < zooCount; ++i) {
+        unique_ptr<WorldZoo> wz(new WorldZoo());
+        zooSeed(seed + i);
+        wz->zoo.reset(new Zoo(L"Зоопарк " + to_wstring(i + 1), L"Директор", scenario));
+        wz->markup = 1.0 + (zooRand() % 51) / 100.0;
+        wz->engine = zooEngine();
+        zoos.push_back(move(wz));
+    }
+    zooEngine() = saved;
+}
+
+void World::step(int threads) {
+    parallelFor(static_cast<int>(zoos.size()), threads, [this](int i) { tickZoo(i); });
+    book.match(day, threads, [this](int zoo, const TradeFill& fill) {
+        WorldZoo& wz = *zoos[zoo];
+        lock_guard<mutex> guard(wz.inboxLock);
+        wz.inbox.push_back(fill);
+    });
+    day++;
+}
+
+int World::getRunning() const {
+    int running = 0;
+    for (const auto& wz : zoos) running += wz->zoo->isOver() ? 0 : 1;
+    return running;
+}
+
+void World::tickZoo(int index) {
+    WorldZoo& wz = *zoos[index];
+    bool wasQuiet = zooQuiet();
+    mt19937 saved = zooEngine();
+    zooQuiet() = true;
+    zooEngine() = wz.engine;
+
+    settle(wz);
+    Zoo& zoo = *wz.zoo;
+    if (!zoo.isOver()) {
+        PolicyPilot::act(zoo, policy);
+        placeOrders(wz, index);
+        zoo.nextDay();
+    }
+
+    wz.engine = zooEngine();
+    zooEngine() = saved;
+    zooQuiet() = wasQuiet;
+}
+
+void World::settle(WorldZoo& wz) {
+    vector<TradeFill> fills;
+    {
+        lock_guard<mutex> guard(wz.inboxLock);
+        fills.swap(wz.inbox);
+    }
+    // Порядок доставки зависит от потоков торгов, порядок разбора - нет
+    sort(fills.begin(), fills.end(), [](const TradeFill& a, const TradeFill& b) {
+        return make_pair(a.order, a.kind) < make_pair(b.order, b.kind);
+    });
+
+    Zoo& zoo = *wz.zoo;
+    for (const TradeFill& fill : fills) {
+        double money = zoo.getMoney() + fill.amount;
+        if (fill.animal) {
+            // Купленное или вернувшееся животное; без места - распродажа за полцены
+            Pen* pen = zoo.findPenFor(fill.animal);
+            if (pen) {
+                pen->addAnimal(fill.animal);
+                if (fill.kind == TradeFill::BOUGHT) zoo.getGenetics().record(*fill.animal);
+            }
+            else {
+                money += fill.animal->getPrice() / 2;
+            }
+        }
+        zoo.setMoney(money);
+        // Сделки биржи сдвигают цены рынка зоопарка так же, как сделки с рынком
+        PriceBoard& prices = zoo.getMarket().getPrices();
+        if (fill.kind == TradeFill::BOUGHT) {
+            prices.recordBuy(fill.animal->getSpeciesId(), zoo.getDay());
+            wz.bought++;
+        }
+        if (fill.kind == TradeFill::SOLD) {
+            prices.recordSell(fill.speciesId, zoo.getDay());
+            wz.sold++;
+        }
+    }
+}
+
+void World::placeOrders(WorldZoo& wz, int index) {
+    const int maxAsks = 2;      // Заявок на продажу в день
+    Zoo& zoo = *wz.zoo;
+    auto nextOrder = [&]() { return (static_cast<uint64_t>(index) << 32) | wz.nextOrder++; };
+
+    // Продажа: из заполненных на три четверти вольеров - самое старое здоровое животное
+    int asks = 0;
+    for (Pen& pen : zoo.getPens()) {
+        if (asks >= maxAsks) break;
+        if (pen.getAnimalCount() * 4 < pen.getCapacity() * 3) continue;
+        const vector<AnimalPtr>& animals = pen.getAnimals();
+        int oldest = -1;
+        for (int k = 0; k < static_cast<int>(animals.size()); ++k) {
+            if (animals[k]->getIsInfected() || animals[k]->getIsDying()) continue;
+            if (oldest < 0 || animals[k]->getBirthDay() < animals[oldest]->getBirthDay()) oldest = k;
+        }
+        if (oldest < 0) continue;
+        TradeAsk ask;
+        ask.animal = animals[oldest];
+        ask.seller = index;
+        ask.price = zoo.sellPrice(*ask.animal) * wz.markup;
+        ask.listedDay = day;
+        ask.order = nextOrder();
+        pen.removeAnimal(oldest);
+        book.post(move(ask));
+        asks++;
+    }
+
+    // Покупка: пара животному, у которого в вольере нет партнера своего вида
+    double reserve = zoo.getWorkers().totalSalary() * 7;
+    for (const Pen& pen : zoo.getPens()) {
+        if (pen.getAnimalCount() >= pen.getCapacity()) continue;
+        const vector<AnimalPtr>& animals = pen.getAnimals();
+        for (const auto& a : animals) {
+            bool paired = false;
+            for (const auto& b : animals) {
+                if (b->getSpeciesId() == a->getSpeciesId() && b->getGender() != a->getGender()) {
+                    paired = true;
+                    break;
+                }
+            }
+            if (paired) continue;
+            double maxPrice = min(zoo.buyPrice(*a) * 1.5, (zoo.getMoney() - reserve) * 0.1);
+            if (maxPrice <= 0) return;
+            TradeBid bid;
+            bid.buyer = index;
+            bid.speciesId = a->getSpeciesId();
+            bid.gender = a->getGender() == MALE ? FEMALE : MALE;
+            bid.maxPrice = maxPrice;
+            bid.order = nextOrder();
+            zoo.setMoney(zoo.getMoney() - maxPrice);
+            book.post(bid);
+            return;             // Одна заявка на покупку в день
+        }
+    }
+}
@@ -0,0 +1,108 @@
+// Мир из многих зоопарков с общей биржей животных
+#pragma once
+
+#include "policy.h"
+
+// Заявка на продажу: животное снято из вольера продавца и лежит на бирже
+// до сделки или до истечения срока
+struct TradeAsk {
+    AnimalPtr animal;
+    int seller = 0;
+    double price = 0.0;
+    int listedDay = 0;
+    uint64_t order = 0;         // Номер заявки: (зоопарк << 32) | счетчик зоопарка
+};
+
+// Заявка на покупку на один день: максимальная цена зарезервирована
+// из денег покупателя и возвращается, если сделки не было
+struct TradeBid {
+    int buyer = 0;
+    int speciesId = 0;
+    int gender = -1;            // -1 - любой пол
+    double maxPrice = 0.0;
+    uint64_t order = 0;
+};
+
+// Итог торгов для одного зоопарка (доставляется в его входящие)
+struct TradeFill {
+    enum Kind { BOUGHT, SOLD, REFUND, RETURNED } kind = REFUND;
+    uint64_t order = 0;         // Заявка, к которой относится итог
+    AnimalPtr animal;           // BOUGHT - купленное, RETURNED - непроданное
+    int speciesId = -1;         // SOLD - вид проданного животного
+    double amount = 0.0;        // SOLD - выручка, BOUGHT и REFUND - возврат резерва
+};
+
+// Биржа, разбитая на сегменты по виду животного. Зоопарки подают заявки
+// параллельно, блокируется только сегмент вида. Торги идут раз в день по
+// сегментам (тоже параллельно): заявки сортируются по цене и номеру, поэтому
+// итог не зависит от того, в каком порядке потоки их подали
+class TradeBook {
+public:
+    static const int LISTING_DAYS = 5;  // Срок заявки на продажу
+
+    explicit TradeBook(int shardCount = 64);
+
+    void post(TradeAsk ask);
+    void post(TradeBid bid);
+
+    // Торги дня; deliver вызывается из потоков торгов для каждого итога
+    void match(int day, int threads, const function<void(int zoo, const TradeFill&)>& deliver);
+
+    long long getTrades() const;
+    double getVolume() const;
+    size_t getOpenAsks() const;
+
+private:
+    struct Shard {
+        mutex lock;
+        vector<TradeAsk> asks;
+        vector<TradeBid> bids;
+        long long trades = 0;
+        double volume = 0.0;
+    };
+    vector<unique_ptr<Shard>> shards;
+
+    Shard& shardOf(int speciesId) { return *shards[speciesId % shards.size()]; }
+
+    static void matchShard(Shard& shard, int day, const function<void(int, const TradeFill&)>& deliver);
+};
+
+// Зоопарк мира: свой генератор, входящие итоги торгов и счетчик заявок
+struct WorldZoo {
+    unique_ptr<Zoo> zoo;
+    mt19937 engine;
+    mutex inboxLock;            // Входящие пополняются из потоков торгов
+    vector<TradeFill> inbox;
+    uint32_t nextOrder = 0;
+    double markup = 1.2;        // Наценка при продаже
+    int bought = 0;
+    int sold = 0;
+};
+
+// Мир: тысячи зоопарков под автопилотом торгуют друг с другом через общую
+// биржу. День мира: все зоопарки параллельно разбирают итоги вчерашних торгов,
+// делают ход автопилота, подают заявки и проживают день; затем идут торги.
+// Результат не зависит от числа потоков
+class World {
+public:
+    World(int zooCount, unsigned seed, const Scenario& scenario, const Policy& policy);
+
+    // Один день мира
+    void step(int threads);
+
+    int getDay() const { return day; }
+    int getZooCount() const { return static_cast<int>(zoos.size()); }
+    int getRunning() const;
+    const Zoo& getZoo(int index) const { return *zoos[index]->zoo; }
+    const TradeBook& getBook() const { return book; }
+
+private:
+    vector<unique_ptr<WorldZoo>> zoos;
+    TradeBook book;
+    Policy policy;
+    int day = 0;
+
+    void tickZoo(int index);
+    void settle(WorldZoo& wz);
+    void placeOrders(WorldZoo& wz, int index);
+};
@@ -0,0 +1,938 @@
+// Зоопарк и сценарий игры
+#include "zoo.h"
+
+uint64_t Scenario::hash() const {
+    uint64_t h = 1469598103934665603ULL;
+    auto mix = [&h](const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            h ^= bytes[i];
+            h *= 1099511628211ULL;
+        }
+    };
+    mix(&startMoney, sizeof(startMoney));
+    mix(&maxAge, sizeof(maxAge));
+    mix(&infectionChance, sizeof(infectionChance));
+    mix(&spreadCount, sizeof(spreadCount));
+    mix(&loanInterest, sizeof(loanInterest));
+    mix(salaries, sizeof(salaries));
+    mix(&maxDays, sizeof(maxDays));
+    return h;
+}
+
+Zoo::Zoo(wstring zooName, wstring directorName, const Scenario& sc)
+    : name(zooName), money(sc.startMoney), popularity(50), day(0), scenario(sc),
+    MAX_AGE(sc.maxAge), MAX_DAYS(sc.maxDays), metrics(MAX_DAYS + 1) {
+    for (int role = 0; role < 4; ++role) {
+        workers.setRate(static_cast<WorkerType>(role), scenario.salaries[role]);
+    }
+    workers.hire(DIRECTOR, directorName);
+    market.open(static_cast<unsigned>(zooRand()));
+}
+
+Zoo Zoo::fork() {
+    for (Pen& pen : pens) pen.share();
+    Zoo branch(*this);
+    branch.market.detach();
+    branch.eventLog = nullptr;
+    return branch;
+}
+
+bool Zoo::buildPen(int capacity, AnimalType type, Climate climate) {
+    int cost = capacity * 10;
+    if (capacity <= 0 || money < cost) return false;
+    money -= cost;
+    pens.emplace_back(nextPenId++, capacity, type, climate);
+    addEvent(L"Построен новый вольер: " +
+        (type == HERBIVORE ? wstring(L"Травоядные") : wstring(L"Хищники")) +
+        L" (" + CLIMATES[climate] + L")");
+    return true;
+}
+
+bool Zoo::buyFood(AnimalType diet, int amount) {
+    if (amount <= 0 || money < amount) return false;
+    addFood(diet, amount);
+    money -= amount;
+    addEvent(L"Куплено " + to_wstring(amount) + L" еды (" + FOOD_TYPES[diet] + L")");
+    return true;
+}
+
+bool Zoo::advertise(int cost) {
+    if (cost <= 0 || money < cost) return false;
+    money -= cost;
+    popularity += cost;
+    addEvent(L"Потрачено $" + to_wstring(cost) + L" на рекламу");
+    return true;
+}
+
+Pen* Zoo::findPenFor(const AnimalPtr& a) {
+    for (Pen& pen : pens) {
+        if (pen.canAdd(a)) return &pen;
+    }
+    return nullptr;
+}
+
+AnimalPtr Zoo::buyFromMarket(int index, Pen& pen) {
+    const vector<AnimalPtr>& offers = market.getAnimals();
+    if (index < 0 || index >= static_cast<int>(offers.size())) return nullptr;
+    AnimalPtr bought = market.buyAnimal(index, buyPrice(*offers[index]), day, money);
+    if (bought) {
+        pen.addAnimal(bought);
+        genetics.record(*bought);
+        animalsBoughtToday++;
+        addEvent(L"Куплено новое животное: " + bought->getName());
+    }
+    return bought;
+}
+
+double Zoo::sellAnimal(int penIndex, int animalIndex) {
+    if (penIndex < 0 || penIndex >= static_cast<int>(pens.size())) return 0.0;
+    Pen& pen = pens[penIndex];
+    if (animalIndex < 0 || animalIndex >= pen.getAnimalCount()) return 0.0;
+    AnimalPtr sold = pen.getAnimals()[animalIndex];
+    double price = sellPrice(*sold);
+    pen.removeAnimal(animalIndex);
+    money += price;
+    market.getPrices().recordSell(sold->getSpeciesId(), day);
+    addEvent(L"Продано животное: " + sold->getName());
+    return price;
+}
+
+int Zoo::speciesPopulation(int speciesId) const {
+    int count = 0;
+    for (const Pen& pen : pens) {
+        for (const auto& sc : pen.getSpeciesCounts()) {
+            if (sc.first == speciesId) count += sc.second;
+        }
+    }
+    for (const auto& a : market.getAnimals()) {
+        if (a->getSpeciesId() == speciesId) count++;
+    }
+    return count;
+}
+
+void Zoo::showEvents() {
+    if (!events.empty()) {
+        if (eventLog) eventLog->insert(eventLog->end(), events.begin(), events.end());
+        zooOut() << L"\nСобытия дня:\n";
+        for (const auto& e : events) {
+            zooOut() << L"- " << e << endl;
+        }
+        events.clear();
+    }
+}
+
+void Zoo::takeLoan(double amount, int days) {
+    money += amount;
+    debt += amount * (1.0 + scenario.loanInterest);
+    dailyDebtPayment = debt / days;
+    debtDaysLeft = days;
+    scheduleLoanPayment(day);
+    addEvent(L"Взят кредит на $" + to_wstring(static_cast<int>(amount)) + L" на " + to_wstring(days) + L" дней");
+}
+
+void Zoo::processDebt() {
+    if (debtDaysLeft > 0) {
+        double payment = min(dailyDebtPayment, debt);
+        if (money >= payment) {
+            money -= payment;
+            debt -= payment;
+            debtDaysLeft--;
+            addEvent(L"Платеж по кредиту: $" + to_wstring(static_cast<int>(payment)));
+        }
+        else {
+            addEvent(L"Просрочка платежа по кредиту!");
+            popularity -= 10;
+        }
+        if (debtDaysLeft > 0) {
+            scheduleLoanPayment(day + 1);
+        }
+    }
+}
+
+void Zoo::dispatchDueEvents(vector<int>& diseasePens) {
+    ScheduledEvent e;
+    while (scheduler.popDue(day, e)) {
+        if (e.kind == EVENT_LOAN_PAYMENT) {
+            processDebt();
+        }
+        else if (e.kind == EVENT_PEN_DISEASE && e.target < static_cast<int>(pens.size())) {
+            diseasePens.push_back(e.target);
+        }
+    }
+}
+
+void Zoo::scheduleLoanPayment(int paymentDay) {
+    if (loanPaymentDay >= paymentDay) return;
+    loanPaymentDay = paymentDay;
+    scheduler.schedule(paymentDay, EVENT_LOAN_PAYMENT);
+}
+
+void Zoo::scheduleDiseaseCheck(int index, int checkDay) {
+    if (pens[index].markDiseaseCheck(checkDay)) {
+        scheduler.schedule(checkDay, EVENT_PEN_DISEASE, index);
+    }
+}
+
+int Zoo::totalAnimals() const {
+    int total = 0;
+    for (const Pen& pen : pens) total += pen.getAnimalCount();
+    return total;
+}
+
+void Zoo::removeWorker(int index) {
+    Worker fired(VET, L"");
+    if (workers.fire(index, fired)) {
+        bool wasDirector = fired.type == DIRECTOR;
+        addEvent(L"Уволен работник: " + fired.name);
+
+        if (wasDirector) {
+            status = DIRECTOR_LOST;
+        }
+    }
+}
+
+void Zoo::removePenLinks(int index) {
+    if (index < static_cast<int>(penLinks.size())) {
+        penLinks.erase(penLinks.begin() + index);
+    }
+    for (auto& links : penLinks) {
+        links.erase(remove(links.begin(), links.end(), index), links.end());
+        for (int& other : links) {
+            if (other > index) other--;
+        }
+    }
+}
+
+bool Zoo::togglePenLink(int a, int b) {
+    syncPenLinks();
+    if (a == b || a < 0 || b < 0 || a >= static_cast<int>(pens.size()) || b >= static_cast<int>(pens.size())) {
+        return false;
+    }
+    if (arePensLinked(a, b)) {
+        penLinks[a].erase(remove(penLinks[a].begin(), penLinks[a].end(), b), penLinks[a].end());
+        penLinks[b].erase(remove(penLinks[b].begin(), penLinks[b].end(), a), penLinks[b].end());
+        addEvent(L"Вольеры " + to_wstring(a + 1) + L" и " + to_wstring(b + 1) + L" больше не соседи");
+        return false;
+    }
+    penLinks[a].push_back(b);
+    penLinks[b].push_back(a);
+    addEvent(L"Вольеры " + to_wstring(a + 1) + L" и " + to_wstring(b + 1) + L" стали соседями");
+    return true;
+}
+
+void Zoo::spreadBetweenPens(const vector<int>& frontier, const vector<int>& infectedCounts, vector<int>& touchedPens) {
+    for (int source : frontier) {
+        if (source >= static_cast<int>(penLinks.size())) continue;
+        int total = pens[source].getAnimalCount();
+        if (total == 0) continue;
+        int chance = CROSS_PEN_CHANCE * infectedCounts[source] / total;
+        for (int target : penLinks[source]) {
+            if (zooRand() % 100 < chance && pens[target].receiveInfection(day)) {
+                scheduleDiseaseCheck(target, day + 1);
+                touchedPens.push_back(target);
+            }
+        }
+    }
+}
+
+void Zoo::destroyPen(int index) {
+    if (index >= 0 && index < pens.size()) {
+        if (pens[index].getAnimalCount() > 0) {
+            zooOut() << L"Нельзя уничтожить вольер с животными!\n";
+            return;
+        }
+
+        pens.erase(pens.begin() + index);
+        removePenLinks(index);
+        scheduler.removePen(index);
+        dirtyPens.removePen(index);
+        triage.removePen(index);
+        addEvent(L"Уничтожен вольер");
+        zooOut() << L"Вольер успешно уничтожен!\n";
+    }
+}
+
+void Zoo::collectInfections(const vector<int>& penIndices) {
+    vector<AnimalPtr> infected;
+    for (int i : penIndices) {
+        pens[i].takeNewInfections(infected);
+        for (const auto& a : infected) triage.add(a, i);
+        infected.clear();
+    }
+}
+
+void Zoo::treatAllAnimals() {
+    vector<AnimalPtr> infected = triage.pending(pens);
+    double totalCost = 100.0 * infected.size();
+
+    if (totalCost > money) {
+        zooOut() << L"Недостаточно средств для лечения всех животных!\n";
+        return;
+    }
+
+    for (auto& animal : infected) {
+        animal->setInfected(false, 0);
+        animal->setDying(false);
+    }
+    triage.clear();
+
+    int treatedCount = static_cast<int>(infected.size());
+    money -= totalCost;
+    addEvent(L"Вылечено " + to_wstring(treatedCount) + L" животных за $" + to_wstring(static_cast<int>(totalCost)));
+    zooOut() << L"Вылечено " << treatedCount << L" животных за $" << static_cast<int>(totalCost) << endl;
+}
+
+void Zoo::autoTreatAnimals() {
+    int vets = workers.count(VET);
+
+    if (vets == 0 || triage.size() == 0) return;
+
+    vector<AnimalPtr> urgent = triage.takeMostUrgent(vets * VET_DAILY_CAPACITY, pens, day);
+    for (auto& animal : urgent) {
+        animal->setInfected(false, 0);
+        animal->setDying(false);
+    }
+
+    int treated = static_cast<int>(urgent.size());
+    if (treated > 0) {
+        addEvent(L"Ветеринары вылечили " + to_wstring(treated) + L" животных");
+    }
+}
+
+void Zoo::renameWorker() {
+    if (workers.empty()) {
+        wcout << L"Нет работников для переименования\n";
+        return;
+    }
+
+    wcout << L"Выберите работника:\n";
+    for (size_t i = 0; i < workers.size(); ++i) {
+        wcout << (i + 1) << L". " << workers[i].name << L" ("
+            << workers[i].getTypeName() << L")\n";
+    }
+
+    int workerIndex;
+    while (true) {
+        wcout << L"Работник (1-" << workers.size() << L", 0 для отмены): ";
+        if (wcin >> workerIndex && (workerIndex == 0 || (workerIndex >= 1 && workerIndex <= static_cast<int>(workers.size())))) break;
+        wcin.clear();
+        wcin.ignore(numeric_limits<streamsize>::max(), L'\n');
+        wcout << L"Ошибка: введите 0 или номер работника\n";
+    }
+    wcin.ignore();
+
+    if (workerIndex == 0) return;
+
+    wstring newName;
+    wcout << L"Введите новое имя: ";
+    getline(wcin, newName);
+    workers[workerIndex - 1].name = newName;
+    wcout << L"Имя изменено!\n";
+    addEvent(L"Работник переименован: " + newName);
+}
+
+void Zoo::hireWorker() {
+    wcout << L"Выберите тип работника:\n";
+    for (size_t i = 0; i < WORKER_TYPES.size(); ++i) {
+        wcout << (i + 1) << L". " << WORKER_TYPES[i] << endl;
+    }
+
+    int typeChoice;
+    while (true) {
+        wcout << L"Тип (1-" << WORKER_TYPES.size() << L", 0 для отмены): ";
+        if (wcin >> typeChoice && (typeChoice == 0 || (typeChoice >= 1 && typeChoice <= static_cast<int>(WORKER_TYPES.size())))) break;
+        wcin.clear();
+        wcin.ignore(numeric_limits<streamsize>::max(), L'\n');
+        wcout << L"Ошибка: введите 0 или число от 1 до " << WORKER_TYPES.size() << endl;
+    }
+    wcin.ignore();
+
+    if (typeChoice == 0) return;
+
+    WorkerType type = static_cast<WorkerType>(typeChoice - 1);
+
+    if (type == DIRECTOR && hasDirector()) {
+        wcout << L"В зоопарке уже есть директор!\n";
+        return;
+    }
+
+    wstring name;
+    while (true) {
+        wcout << L"Введите имя работника: ";
+        getline(wcin, name);
+        if (!name.empty()) break;
+        wcout << L"Имя не может быть пустым!\n";
+    }
+
+    workers.hire(type, name);
+    wcout << WORKER_TYPES[typeChoice - 1] << L" " << name << L" нанят!\n";
+    addEvent(L"Нанят новый работник: " + name + L" (" + WORKER_TYPES[typeChoice - 1] + L")");
+}
+
+void Zoo::randomEvents() {
+    lastCelebCount = zooRand() % 3;
+    lastPhotographerCount = zooRand() % 6;
+
+    int bonus = lastCelebCount * 10 + lastPhotographerCount * 5;
+
+    if (lastCelebCount > 0 || lastPhotographerCount > 0) {
+        wstring eventMsg = L"Посетители дня: ";
+        if (lastCelebCount > 0) {
+            eventMsg += to_wstring(lastCelebCount) + L" знаменитост" +
+                (lastCelebCount == 1 ? L"ь" : (lastCelebCount < 5 ? L"и" : L"ей")) + L" (+" +
+                to_wstring(lastCelebCount * 10) + L")";
+            if (lastPhotographerCount > 0) eventMsg += L", ";
+        }
+        if (lastPhotographerCount > 0) {
+            eventMsg += to_wstring(lastPhotographerCount) + L" фотограф" +
+                (lastPhotographerCount == 1 ? L"" : (lastPhotographerCount < 5 ? L"а" : L"ов")) + L" (+" +
+                to_wstring(lastPhotographerCount * 5) + L")";
+        }
+        addEvent(eventMsg);
+    }
+
+    popularity += bonus;
+}
+
+void Zoo::showAllPens() const {
+    const int pensPerPage = 10;
+    int page = 0;
+    while (true) {
+        int pages = max(1, static_cast<int>((pens.size() + pensPerPage - 1) / pensPerPage));
+        page = min(max(page, 0), pages - 1);
+        int first = page * pensPerPage;
+        int last = min(first + pensPerPage, static_cast<int>(pens.size()));
+
+        wcout << L"\nВольеры (страница " << page + 1 << L"/" << pages << L"):\n";
+        for (int i = first; i < last; ++i) {
+            const Pen& pen = pens[i];
+            wcout << i + 1 << L". " << pen.getDescription() << endl;
+            wcout << L"   Животных: " << pen.getAnimalCount() << L"/" << pen.getCapacity()
+                << L", зараженных: " << pen.getInfectedCount() << endl;
+            wcout << L"   Чистота: " << (pen.getIsClean() ? L"Чистый" : L"Грязный") << endl;
+            if (i < static_cast<int>(penLinks.size()) && !penLinks[i].empty()) {
+                wcout << L"   Соседи:";
+                for (int n : penLinks[i]) wcout << L" " << n + 1;
+                wcout << endl;
+            }
+        }
+
+        wcout << L"Номер вольера - содержимое, > / < - страница, 0 - назад: ";
+        wstring line;
+        if (!getline(wcin, line) || line.empty() || line == L"0") return;
+
+        if (line == L">") {
+            page++;
+        }
+        else if (line == L"<") {
+            page--;
+        }
+        else {
+            int number = AnimalPager::parseNumber(line);
+            if (number >= 1 && number <= static_cast<int>(pens.size())) {
+                const Pen& pen = pens[number - 1];
+                wcout << L"\n" << pen.getDescription() << L":\n";
+                if (pen.getAnimalCount() == 0) {
+                    wcout << L"   пусто\n";
+                }
+                else {
+                    AnimalPager::browse(pen.getAnimals(), day, ROW_FULL, false);
+                }
+            }
+            else {
+                wcout << L"Ошибка: неизвестная команда\n";
+            }
+        }
+    }
+}
+
+void Zoo::recordMetrics() {
+    vector<pair<int, int>> speciesCounts;
+    vector<pair<int, int>> penCounts;
+    penCounts.reserve(pens.size());
+    today.animals = 0;
+    for (const Pen& pen : pens) {
+        penCounts.push_back(make_pair(pen.getId(), pen.getAnimalCount()));
+        today.animals += pen.getAnimalCount();
+        const vector<pair<int, int>>& counts = pen.getSpeciesCounts();
+        speciesCounts.insert(speciesCounts.end(), counts.begin(), counts.end());
+    }
+    recordMetrics(speciesCounts, penCounts);
+}
+
+void Zoo::recordMetrics(const vector<pair<int, int>>& speciesCounts, const vector<pair<int, int>>& penCounts) {
+    today.day = day;
+    today.money = money;
+    today.debt = debt;
+    today.food = food.total();
+    today.popularity = popularity;
+    metrics.record(today, speciesCounts, penCounts);
+}
+
+GameStatus Zoo::nextDay() {
+    if (status != RUNNING) return status;
+
+    if (day >= MAX_DAYS) {
+        status = VICTORY;
+        return status;
+    }
+
+    if (!hasDirector()) {
+        status = DIRECTOR_LOST;
+        return status;
+    }
+
+    animalsBoughtToday = 0;
+    today = DayMetrics();
+    vector<int> diseasePens;    // Вольеры с наступившей проверкой болезни
+    vector<int> touchedPens;    // Вольеры, заразившиеся от соседей
+    // Животные стареют в начале хода: их возраст в этом ходу считается на завтра
+    int ageDay = day + 1;
+    {
+        ZOO_PHASE_SCOPE(profiler, PHASE_DEBT);
+        dispatchDueEvents(diseasePens);
+    }
+
+    // Обновление чистоты вольеров
+    {
+        ZOO_PHASE_SCOPE(profiler, PHASE_CLEANLINESS);
+        for (size_t i = 0; i < pens.size(); ++i) {
+            pens[i].updateCleanliness(i, dirtyPens);
+        }
+        ZOO_PROFILE_COUNT(profiler, PHASE_CLEANLINESS, pens.size());
+    }
+
+    // Обработка болезней
+    {
+        ZOO_PHASE_SCOPE(profiler, PHASE_DISEASE);
+        syncPenLinks();
+        for (size_t i = 0; i < pens.size(); ++i) {
+            int chance = infectionPlan ? ((*infectionPlan)[i] ? 100 : 0) : scenario.infectionChance;
+            if (pens[i].infectRandomAnimal(day, chance)) {
+                scheduleDiseaseCheck(i, day);
+            }
+        }
+        ZOO_PROFILE_COUNT(profiler, PHASE_DISEASE, pens.size());
+        dispatchDueEvents(diseasePens);
+        // Вольеры обрабатываются по порядку номеров, как при обходе всех вольеров
+        sort(diseasePens.begin(), diseasePens.end());
+        diseasePens.erase(unique(diseasePens.begin(), diseasePens.end()), diseasePens.end());
+
+        // Распространение и вспышки только в вольерах с наступившей проверкой
+        vector<int> frontier;
+        vector<int> infectedCounts(pens.size(), 0);
+        for (int i : diseasePens) {
+            Pen& pen = pens[i];
+            pen.spreadDisease(day, scenario.spreadCount);
+            pen.handleOutbreak(day);
+            ZOO_PROFILE_COUNT(profiler, PHASE_DISEASE, pen.getAnimalCount());
+            if (!penLinks[i].empty()) {
+                infectedCounts[i] = pen.getInfectedCount();
+                if (infectedCounts[i] > 0) frontier.push_back(i);
+            }
+        }
+        spreadBetweenPens(frontier, infectedCounts, touchedPens);
+        collectInfections(diseasePens);
+        collectInfections(touchedPens);
+    }
+
+    // Автоматическое лечение
+    {
+        ZOO_PHASE_SCOPE(profiler, PHASE_AUTO_TREAT);
+        autoTreatAnimals();
+    }
+
+    // Обработка умирающих животных
+    {
+        ZOO_PHASE_SCOPE(profiler, PHASE_DYING);
+        for (int i : diseasePens) {
+            Pen& pen = pens[i];
+            pen.handleDying(MAX_AGE, ageDay, today.deaths[DEATH_DISEASE], today.deaths[DEATH_OLD_AGE]);
+            if (pen.hasActiveDisease()) {
+                scheduleDiseaseCheck(i, day + 1);
+            }
+        }
+        ZOO_PROFILE_COUNT(profiler, PHASE_DYING, diseasePens.size());
+    }
+
+    // Кормление животных
+    {
+        ZOO_PHASE_SCOPE(profiler, PHASE_FEEDING);
+        int spoiled = food.removeExpired(day);
+        if (spoiled > 0) {
+            addEvent(L"Испортилось " + to_wstring(spoiled) + L" еды");
+        }
+
+        // Каждый вольер получает корм своего вида целиком; голодные животные
+        // погибают с вероятностью 1/2
+        bool shortage = false;
+        for (Pen& pen : pens) {
+            int needed = pen.getAnimalCount();
+            if (needed == 0) continue;
+            int unfed = needed - food.consume(pen.getAllowedType(), needed);
+            ZOO_PROFILE_COUNT(profiler, PHASE_FEEDING, 1);
+            if (unfed == 0) continue;
+
+            if (!shortage) {
+                shortage = true;
+                addEvent(L"Не хватило еды для всех животных!");
+            }
+            int deadCount = sampleStarvationDeaths(unfed);
+            if (deadCount == 0) continue;
+
+            // Погибают случайные животные из оставшихся без корма (последних в вольере)
+            pen.starve(needed - unfed, deadCount);
+
+            today.deaths[DEATH_STARVATION] += deadCount;
+            addEvent(L"В вольере " + pen.getDescription() + L" умерло " + to_wstring(deadCount) + L" животных из-за голода!");
+        }
+    }
+
+    // Уборка вольеров
+    {
+        ZOO_PHASE_SCOPE(profiler, PHASE_CLEANING);
+        vector<int> toClean = dirtyPens.take(workers.count(CLEANER), cleaningPriority, pens);
+        for (int i : toClean) {
+            pens[i].setClean(true);
+        }
+        ZOO_PROFILE_COUNT(profiler, PHASE_CLEANING, toClean.size());
+    }
+
+    // Расчет популярности
+    {
+        ZOO_PHASE_SCOPE(profiler, PHASE_POPULARITY);
+        // В очереди уборки находятся все грязные вольеры
+        int dirtyCount = static_cast<int>(dirtyPens.size());
+        int totalInfected = 0;
+        // Зараженные могут быть только в вольерах с активной болезнью
+        vector<int> activePens = diseasePens;
+        activePens.insert(activePens.end(), touchedPens.begin(), touchedPens.end());
+        sort(activePens.begin(), activePens.end());
+        activePens.erase(unique(activePens.begin(), activePens.end()), activePens.end());
+        for (int i : activePens) totalInfected += pens[i].getInfectedCount();
+        today.infected = totalInfected;
+        if (visitorModel.isEnabled()) {
+            // Грязь, болезни и толпа уже учтены в впечатлениях посетителей
+            visitorDay = visitorModel.simulate(pens, popularity, static_cast<uint32_t>(zooRand()));
+            ZOO_PROFILE_COUNT(profiler, PHASE_POPULARITY, visitorDay.simulated);
+            int change = static_cast<int>(lround((visitorDay.satisfaction - 0.8) * 25.0));
+            if (visitorDay.simulated == 0) change = -dirtyCount - totalInfected;
+            popularity = max(popularity + change, 0);
+        }
+        else {
+            popularity = max(popularity - dirtyCount - totalInfected + (zooRand() % 21 - 10), 0);
+        }
+    }
+
+    // Выплата зарплат
+    {
+        ZOO_PHASE_SCOPE(profiler, PHASE_SALARIES);
+        double totalSalary = workers.totalSalary();
+        money -= totalSalary;
+        today.salary = totalSalary;
+        ZOO_PROFILE_COUNT(profiler, PHASE_SALARIES, workers.size());
+        addEvent(L"Зарплата работникам: $" + to_wstring(static_cast<int>(totalSalary)));
+    }
+
+    // Доход от посетителей
+    {
+        ZOO_PHASE_SCOPE(profiler, PHASE_INCOME);
+        if (visitorModel.isEnabled()) {
+            if (visitorDay.simulated > 0) {
+                money += visitorDay.income;
+                today.visitorIncome = visitorDay.income;
+                addEvent(L"Посетителей: " + to_wstring(visitorDay.visitors) + L", удовлетворенность " +
+                    to_wstring(static_cast<int>(visitorDay.satisfaction * 100)) + L"%, доход: $" +
+                    to_wstring(static_cast<int>(visitorDay.income)));
+            }
+        }
+        else if (totalAnimals() > 0) {
+            int visitors = static_cast<int>(2 * popularity);
+            money += visitors * max(totalAnimals(), 1);
+            today.visitorIncome = visitors * max(totalAnimals(), 1);
+            addEvent(L"Доход от посетителей: $" + to_wstring(visitors * max(totalAnimals(), 1)));
+        }
+    }
+
+    // Проверка на банкротство
+    if (money < 0) {
+        status = BANKRUPT;
+        recordMetrics();
+        ZOO_PROFILE_END_DAY(profiler);
+        return status;
+    }
+
+    // Обновление рынка животных
+    {
+        ZOO_PHASE_SCOPE(profiler, PHASE_MARKET);
+        market.nextIssue(day);
+    }
+
+    // Случайные события
+    {
+        ZOO_PHASE_SCOPE(profiler, PHASE_RANDOM_EVENTS);
+        randomEvents();
+    }
+    recordMetrics();
+    ZOO_PROFILE_END_DAY(profiler);
+    showEvents();
+
+    day++;
+    return status;
+}
+
+bool Zoo::isQuiet() const {
+    if (status != RUNNING || day >= MAX_DAYS || !hasDirector()) return false;
+    if (visitorModel.isEnabled() || !dirtyPens.empty()) return false;
+    // Уборщики убирают все загрязнившиеся за день вольеры в тот же день
+    if (workers.count(CLEANER) < static_cast<int>(pens.size())) return false;
+    // Без зараженных и вспышек оставшиеся проверки болезни и записи очереди
+    // лечения ничего не делают; пропущенные проверки снимает advanceQuietDays
+    for (const Pen& pen : pens) {
+        if (pen.getOutbreakStarted()) return false;
+        for (const auto& a : pen.getAnimals()) {
+            if (a->getIsInfected() || a->getIsDying()) return false;
+        }
+    }
+    return true;
+}
+
+int Zoo::fastForward(int maxDays) {
+    int start = day;
+    while (day - start < maxDays && !isOver()) {
+        if (!isQuiet()) {
+            nextDay();
+            if (day == start + maxDays || status != RUNNING) break;
+            continue;
+        }
+
+        // День первого заражения каждого вольера с животными (через сколько дней)
+        double p = scenario.infectionChance / 100.0;
+        vector<int> firstInfection(pens.size(), INT_MAX);
+        int first = INT_MAX;
+        for (size_t i = 0; i < pens.size() && p > 0; ++i) {
+            if (pens[i].getAnimalCount() == 0) continue;
+            firstInfection[i] = p >= 1.0 ? 0 : geometric_distribution<int>(p)(zooEngine());
+            first = min(first, firstInfection[i]);
+        }
+
+        int limit = min(min(maxDays - (day - start), MAX_DAYS - day), first);
+        int advanced = advanceQuietDays(limit);
+        if (day - start >= maxDays || isOver()) break;
+
+        if (advanced == first) {
+            // Настал день заражения: заражаются вольеры, выпавшие на этот день, и только они
+            vector<char> plan(pens.size(), 0);
+            for (size_t i = 0; i < pens.size(); ++i) plan[i] = firstInfection[i] == first ? 1 : 0;
+            infectionPlan = &plan;
+            nextDay();
+            infectionPlan = nullptr;
+        }
+        else {
+            nextDay();
+        }
+    }
+    return day - start;
+}
+
+int Zoo::advanceQuietDays(int limit) {
+    int eaters[2] = { 0, 0 };
+    vector<pair<int, int>> speciesCounts;
+    vector<pair<int, int>> penCounts;
+    for (const Pen& pen : pens) {
+        eaters[pen.getAllowedType()] += pen.getAnimalCount();
+        penCounts.push_back(make_pair(pen.getId(), pen.getAnimalCount()));
+        const vector<pair<int, int>>& counts = pen.getSpeciesCounts();
+        speciesCounts.insert(speciesCounts.end(), counts.begin(), counts.end());
+    }
+    int animals = eaters[HERBIVORE] + eaters[CARNIVORE];
+    double salary = workers.totalSalary();
+
+    int from = day;
+    double income = 0.0;
+    double paid = 0.0;
+    int spoiled = 0;
+    int advanced = 0;
+    while (advanced < limit) {
+        double payment = debtDaysLeft > 0 ? min(dailyDebtPayment, debt) : 0.0;
+        if (money - payment - salary < 0) break;
+        if (food.fresh(HERBIVORE, day) < eaters[HERBIVORE] || food.fresh(CARNIVORE, day) < eaters[CARNIVORE]) break;
+
+        animalsBoughtToday = 0;
+        today = DayMetrics();
+        if (debtDaysLeft > 0) {
+            money -= payment;
+            debt -= payment;
+            debtDaysLeft--;
+            paid += payment;
+        }
+        spoiled += food.removeExpired(day);
+        food.consume(HERBIVORE, eaters[HERBIVORE]);
+        food.consume(CARNIVORE, eaters[CARNIVORE]);
+
+        // Порядок розыгрыша тот же, что в обычном ходе
+        popularity = max(popularity + (zooRand() % 21 - 10), 0);
+        money -= salary;
+        today.salary = salary;
+        if (animals > 0) {
+            today.visitorIncome = static_cast<int>(2 * popularity) * animals;
+            money += today.visitorIncome;
+            income += today.visitorIncome;
+        }
+        market.nextIssue(day);
+        lastCelebCount = zooRand() % 3;
+        lastPhotographerCount = zooRand() % 6;
+        popularity += lastCelebCount * 10 + lastPhotographerCount * 5;
+
+        today.animals = animals;
+        recordMetrics(speciesCounts, penCounts);
+        day++;
+        advanced++;
+    }
+    if (advanced == 0) return 0;
+
+    // Платеж по кредиту, запланированный на первый из прожитых дней, уже учтен
+    ScheduledEvent due;
+    while (scheduler.popDue(day - 1, due)) {}
+    if (debtDaysLeft > 0) scheduleLoanPayment(day);
+
+    wstring summary = L"Спокойные дни " + to_wstring(from + 1) + L"-" + to_wstring(day) +
+        L": доход $" + to_wstring(static_cast<long long>(income)) +
+        L", зарплата $" + to_wstring(static_cast<long long>(salary * advanced));
+    if (paid > 0) summary += L", платежи по кредиту $" + to_wstring(static_cast<long long>(paid));
+    if (spoiled > 0) summary += L", испортилось еды: " + to_wstring(spoiled);
+    addEvent(summary);
+    showEvents();
+    return advanced;
+}
+
+bool Zoo::manualBreeding() {
+    if (pens.empty()) {
+        wcout << L"Нет вольеров с животными\n";
+        return false;
+    }
+
+    wcout << L"Выберите вольер для первого животного:\n";
+    for (size_t i = 0; i < pens.size(); ++i) {
+        wcout << (i + 1) << L". " << pens[i].getDescription() << L" ("
+            << pens[i].getAnimalCount() << L" животных)\n";
+    }
+
+    int pen1Index;
+    while (true) {
+        wcout << L"Вольер (1-" << pens.size() << L", 0 для отмены): ";
+        if (wcin >> pen1Index && (pen1Index == 0 || (pen1Index >= 1 && pen1Index <= static_cast<int>(pens.size())))) break;
+        wcin.clear();
+        wcin.ignore(numeric_limits<streamsize>::max(), L'\n');
+        wcout << L"Ошибка: введите 0 или число от 1 до " << pens.size() << endl;
+    }
+    wcin.ignore();
+
+    if (pen1Index == 0) return false;
+
+    Pen& pen1 = pens[pen1Index - 1];
+    if (pen1.getAnimalCount() == 0) {
+        wcout << L"Вольер пуст\n";
+        return false;
+    }
+
+    wcout << L"Выберите первое животное:\n";
+    int animal1Index = AnimalPager::browse(pen1.getAnimals(), day, ROW_BRIEF, true) + 1;
+
+    if (animal1Index == 0) return false;
+
+    AnimalPtr animal1 = pen1.getAnimals()[animal1Index - 1];
+
+    wcout << L"Выберите вольер для второго животного:\n";
+    for (size_t i = 0; i < pens.size(); ++i) {
+        wcout << (i + 1) << L". " << pens[i].getDescription() << L" ("
+            << pens[i].getAnimalCount() << L" животных)\n";
+    }
+
+    int pen2Index;
+    while (true) {
+        wcout << L"Вольер (1-" << pens.size() << L", 0 для отмены): ";
+        if (wcin >> pen2Index && (pen2Index == 0 || (pen2Index >= 1 && pen2Index <= static_cast<int>(pens.size())))) break;
+        wcin.clear();
+        wcin.ignore(numeric_limits<streamsize>::max(), L'\n');
+        wcout << L"Ошибка: введите 0 или число от 1 до " << pens.size() << endl;
+    }
+    wcin.ignore();
+
+    if (pen2Index == 0) return false;
+
+    Pen& pen2 = pens[pen2Index - 1];
+    if (pen2.getAnimalCount() == 0) {
+        wcout << L"Вольер пуст\n";
+        return false;
+    }
+
+    wcout << L"Выберите второе животное:\n";
+    int animal2Index = AnimalPager::browse(pen2.getAnimals(), day, ROW_BRIEF, true) + 1;
+
+    if (animal2Index == 0) return false;
+
+    AnimalPtr animal2 = pen2.getAnimals()[animal2Index - 1];
+
+    return pen1.tryManualBreeding(animal1, animal2, *this);
+}
+
+bool Zoo::treatAnimal() {
+    if (pens.empty()) {
+        wcout << L"Нет животных для лечения\n";
+        return false;
+    }
+
+    wcout << L"Выберите вольер:\n";
+    for (size_t i = 0; i < pens.size(); ++i) {
+        wcout << (i + 1) << L". " << pens[i].getDescription() << endl;
+    }
+
+    int penIndex;
+    while (true) {
+        wcout << L"Вольер (1-" << pens.size() << L", 0 для отмены): ";
+        if (wcin >> penIndex && (penIndex == 0 || (penIndex >= 1 && penIndex <= static_cast<int>(pens.size())))) break;
+        wcin.clear();
+        wcin.ignore(numeric_limits<streamsize>::max(), L'\n');
+        wcout << L"Ошибка: введите 0 или корректный номер\n";
+    }
+    wcin.ignore();
+
+    if (penIndex == 0) return false;
+
+    ownPen(penIndex - 1);
+    Pen& selectedPen = pens[penIndex - 1];
+    const vector<AnimalPtr>& animals = selectedPen.getAnimals();
+
+    if (animals.empty()) {
+        wcout << L"Вольер пуст\n";
+        return false;
+    }
+
+    wcout << L"Выберите животное:\n";
+    int animalIndex = AnimalPager::browse(animals, day, ROW_DETAILED, true) + 1;
+
+    if (animalIndex == 0) return false;
+
+    AnimalPtr selectedAnimal = animals[animalIndex - 1];
+
+    if (selectedAnimal->getIsInfected()) {
+        if (money >= 100) {
+            selectedAnimal->setInfected(false, 0);
+            selectedAnimal->setDying(false);
+            money -= 100;
+            wcout << L"Животное вылечено!\n";
+            addEvent(L"Вылечено животное: " + selectedAnimal->getName());
+            return true;
+        }
+        else {
+            wcout << L"Недостаточно средств\n";
+            return false;
+        }
+    }
+    else {
+        wcout << L"Животное не заражено\n";
+        return false;
+    }
+}
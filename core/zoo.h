@@ -0,0 +1,313 @@
+// Зоопарк и сценарий игры
+#pragma once
+
+#include "staff.h"
+#include "pen.h"
+#include "pager.h"
+#include "market.h"
+#include "metrics.h"
+#include "scheduler.h"
+#include "visitors.h"
+#include "profiler.h"
+
+// Параметры сценария: исходные константы игры, которые меняются в серийных
+// прогонах (по умолчанию - значения обычной игры)
+struct Scenario {
+    double startMoney = 10000.0; // Стартовый капитал
+    int maxAge = 30;            // Возраст, после которого животные умирают от старости
+    int infectionChance = 35;   // Ежедневный шанс (%) заражения в вольере
+    int spreadCount = 2;        // Сколько здоровых заражает больной за день
+    double loanInterest = 0.2;  // Процент по кредиту
+    double salaries[4] = { 50.0, 20.0, 30.0, 500.0 }; // Зарплаты по должностям
+    int maxDays = 50;           // Длина игры в днях
+
+    // Хеш FNV-1a по всем полям (ключ кэша результатов)
+    uint64_t hash() const;
+};
+
+// Класс, представляющий зоопарк
+class Zoo {
+private:
+    wstring name;               // Название зоопарка
+    double money;               // Деньги
+    FoodStock food;             // Склад корма
+    int popularity;             // Популярность зоопарка
+    vector<Pen> pens;           // Вольеры
+    int nextPenId = 0;          // Номер следующего построенного вольера
+    vector<vector<int>> penLinks; // Соседство вольеров (списки смежности по номерам)
+    WorkerRoster workers;       // Работники по должностям
+    int day;                    // Текущий день
+    AnimalMarket market;        // Рынок животных
+    Scenario scenario;          // Параметры сценария
+    const int MAX_AGE = 30;     // Максимальный возраст животных
+    const int MAX_DAYS = 50;    // Максимальное количество дней игры
+    const int CROSS_PEN_CHANCE = 20; // Шанс (%) заражения соседа при полностью зараженном вольере
+    const int VET_DAILY_CAPACITY = 20; // Сколько животных ветеринар может вылечить за день
+    int animalsBoughtToday = 0; // Количество купленных сегодня животных
+    double debt = 0.0;          // Долг
+    double dailyDebtPayment = 0.0; // Ежедневный платеж по долгу
+    int debtDaysLeft = 0;       // Оставшееся количество дней по кредиту
+    int loanPaymentDay = -1;    // День запланированного платежа по кредиту
+    vector<wstring> events;     // События дня
+    vector<wstring>* eventLog = nullptr; // Куда копируются события дня (без консоли)
+    GameStatus status = RUNNING; // Состояние игры
+    DayScheduler scheduler;     // Запланированные события (кредит, болезни в вольерах)
+    DirtyPenQueue dirtyPens;    // Очередь грязных вольеров
+    TriageQueue triage;         // Очередь лечения зараженных животных
+    CleaningPriority cleaningPriority = CLEAN_OLDEST_FIRST; // Порядок уборки
+    DayMetrics today;           // Показатели текущего дня
+    MetricsRecorder metrics;    // Журнал показателей по дням
+    VisitorModel visitorModel;  // Агентная модель посетителей (по умолчанию выключена)
+    PopulationGenetics genetics; // Генетика животных по видам и поколениям
+    VisitorDayResult visitorDay; // Итоги посетителей текущего дня
+#ifdef ZOO_PROFILE
+    DayProfiler profiler;       // Профиль фаз дневного хода
+#endif
+    const vector<char>* infectionPlan = nullptr; // Заражения дня при перемотке (вольер -> заразится ли)
+    int lastCelebCount = 0;     // Количество знаменитостей вчера
+    int lastPhotographerCount = 0; // Количество фотографов вчера
+
+    friend class ReferenceTick;
+    friend class DifferentialHarness;
+
+public:
+    // Конструктор зоопарка
+    Zoo(wstring zooName, wstring directorName, const Scenario& sc = Scenario());
+
+    // Ветка для анализа "что если": копия состояния, в которой вольеры
+    // делят животных с исходным зоопарком. Животные вольера копируются,
+    // только когда одна из веток его меняет (родословная остается общей),
+    // так что десятки веток от одного состояния почти ничего не стоят.
+    // Ветки можно прогонять в разных потоках; исходный зоопарк в это время
+    // не должен меняться
+    Zoo fork();
+
+    // Собственные копии животных вольера перед изменением животных
+    // (ничего не делает, если вольер ни с какой веткой не делится)
+    void ownPen(int index) { pens[index].own(); }
+    void ownPens() {
+        for (int i = 0; i < static_cast<int>(pens.size()); ++i) ownPen(i);
+    }
+
+    // Геттеры
+    wstring getName() const { return name; }
+    int getDay() const { return day; }
+    double getMoney() const { return money; }
+    int getFood() const { return food.total(); }
+    int getFood(AnimalType diet) const { return food.total(diet); }
+    const FoodStock& getFoodStock() const { return food; }
+    int getPopularity() const { return popularity; }
+    vector<Pen>& getPens() { return pens; }
+    WorkerRoster& getWorkers() { return workers; }
+    AnimalMarket& getMarket() { return market; }
+    double getDebt() const { return debt; }
+    int getDebtDaysLeft() const { return debtDaysLeft; }
+    int getMaxDays() const { return MAX_DAYS; }
+    int getMaxAge() const { return MAX_AGE; }
+    const Scenario& getScenario() const { return scenario; }
+    GameStatus getStatus() const { return status; }
+    CleaningPriority getCleaningPriority() const { return cleaningPriority; }
+    void setCleaningPriority(CleaningPriority priority) { cleaningPriority = priority; }
+    const MetricsRecorder& getMetrics() const { return metrics; }
+    const VisitorModel& getVisitorModel() const { return visitorModel; }
+    PopulationGenetics& getGenetics() { return genetics; }
+    const VisitorDayResult& getVisitorDay() const { return visitorDay; }
+#ifdef ZOO_PROFILE
+    const DayProfiler& getProfiler() const { return profiler; }
+#endif
+    bool isOver() const { return status != RUNNING; }
+
+    // Сеттеры
+    void setMoney(double m) { money = m; }
+    // Закупка партии корма
+    void addFood(AnimalType diet, int amount) { food.add(diet, amount, day); }
+    void setPopularity(int p) { popularity = p; }
+    // Включение агентной модели посетителей вместо формулы дохода
+    void enableVisitorModel(int maxSimulated, int threads) { visitorModel.enable(maxSimulated, threads); }
+
+    // Строительство вольера (стоимость - вместимость * 10)
+    bool buildPen(int capacity, AnimalType type, Climate climate);
+
+    // Закупка корма (1 еда = $1)
+    bool buyFood(AnimalType diet, int amount);
+
+    // Реклама ($1 = +1 популярность)
+    bool advertise(int cost);
+
+    // Первый вольер, в который можно поместить животное
+    Pen* findPenFor(const AnimalPtr& a);
+
+    // Покупка животного с рынка в указанный вольер по текущей цене рынка
+    AnimalPtr buyFromMarket(int index, Pen& pen);
+
+    // Продажа животного рынку, возвращает выручку (0 - нет такого животного)
+    double sellAnimal(int penIndex, int animalIndex);
+
+    // Сколько животных вида видно зоопарку: в вольерах и на рынке. Считается
+    // при каждом запросе по счетчикам видов вольеров (Pen::countSpecies),
+    // поэтому продажа, покупка, рождение и гибель сразу меняют цену
+    int speciesPopulation(int speciesId) const;
+
+    // Текущие цены рынка для животного: покупка у рынка и продажа рынку
+    double buyPrice(const Animal& a) const {
+        return market.getPrices().ask(a, speciesPopulation(a.getSpeciesId()), MAX_AGE, day);
+    }
+    double sellPrice(const Animal& a) const {
+        return market.getPrices().bid(a, speciesPopulation(a.getSpeciesId()), MAX_AGE, day);
+    }
+
+    // Добавление события в журнал
+    void addEvent(const wstring& event) {
+        events.push_back(event);
+    }
+
+    // Отображение событий дня
+    void showEvents();
+
+    // Журнал, в который showEvents копирует события (nullptr - не копировать)
+    void setEventLog(vector<wstring>* log) { eventLog = log; }
+
+    // Взятие кредита
+    void takeLoan(double amount, int days);
+
+    // Обработка платежей по долгу (вызывается по событию планировщика)
+    void processDebt();
+
+    // Обработка наступивших событий: платежи по кредиту выполняются сразу,
+    // вольеры с проверкой болезни добавляются в список
+    void dispatchDueEvents(vector<int>& diseasePens);
+
+    // Планирование платежа по кредиту (без повторов на один день)
+    void scheduleLoanPayment(int paymentDay);
+
+    // Планирование проверки болезни в вольере
+    void scheduleDiseaseCheck(int index, int checkDay);
+
+    // Подсчет общего количества животных
+    int totalAnimals() const;
+
+    // Расчет необходимого количества ветеринаров
+    int calculateNeededVets() const {
+        return (totalAnimals() + 19) / 20;
+    }
+
+    // Расчет необходимого количества уборщиков
+    int calculateNeededCleaners() const {
+        return pens.size();
+    }
+
+    // Расчет необходимого количества кормильщиков
+    int calculateNeededFeeders() const {
+        return (pens.size() + 1) / 2;
+    }
+
+    // Проверка наличия директора
+    bool hasDirector() const {
+        return workers.count(DIRECTOR) > 0;
+    }
+
+    // Увольнение работника
+    void removeWorker(int index);
+
+    // Список смежности растет вместе с вольерами
+    void syncPenLinks() {
+        if (penLinks.size() < pens.size()) penLinks.resize(pens.size());
+    }
+
+    // Удаление вольера из графа соседства со сдвигом номеров
+    void removePenLinks(int index);
+
+    // Проверка соседства двух вольеров
+    bool arePensLinked(int a, int b) const {
+        if (a < 0 || a >= static_cast<int>(penLinks.size())) return false;
+        return find(penLinks[a].begin(), penLinks[a].end(), b) != penLinks[a].end();
+    }
+
+    // Соседи вольера
+    vector<int> getPenNeighbors(int index) const {
+        if (index < 0 || index >= static_cast<int>(penLinks.size())) return vector<int>();
+        return penLinks[index];
+    }
+
+    // Соединение или разъединение двух вольеров (возвращает true, если теперь соседи)
+    bool togglePenLink(int a, int b);
+
+    // Распространение болезни между соседними вольерами.
+    // Обходятся только вольеры фронта (с активной инфекцией) и их соседи;
+    // заразившиеся сегодня вольеры передают болезнь дальше не раньше завтрашнего дня
+    void spreadBetweenPens(const vector<int>& frontier, const vector<int>& infectedCounts, vector<int>& touchedPens);
+
+    // Уничтожение вольера
+    void destroyPen(int index);
+
+    // Число погибших от голода среди unfed животных (биномиальное распределение, p = 1/2)
+    static int sampleStarvationDeaths(int unfed) {
+        binomial_distribution<int> deaths(unfed, 0.5);
+        return deaths(zooEngine());
+    }
+
+    // Передача новых заражений из вольеров в очередь лечения
+    void collectInfections(const vector<int>& penIndices);
+
+    // Лечение всех животных
+    void treatAllAnimals();
+
+    // Автоматическое лечение: каждый ветеринар за день лечит до VET_DAILY_CAPACITY
+    // самых срочных животных из очереди
+    void autoTreatAnimals();
+
+    // Переименование работника
+    void renameWorker();
+
+    // Наем работника
+    void hireWorker();
+
+    // Случайные события дня
+    void randomEvents();
+
+    // Спокойные дни пачкой (не больше limit). Останавливается раньше, если
+    // на следующий день не хватит корма или денег на зарплату и кредит
+    int advanceQuietDays(int limit);
+
+    // Отображение вольеров постранично (содержимое вольера открывается по номеру)
+    void showAllPens() const;
+
+    // Запись показателей дня в журнал. Численность по видам и вольерам берется
+    // из счетчиков вольеров, без обхода животных; число зараженных
+    // (today.infected) к этому моменту уже посчитано ходом
+    void recordMetrics();
+    void recordMetrics(const vector<pair<int, int>>& speciesCounts, const vector<pair<int, int>>& penCounts);
+
+    // Переход на следующий день (возвращает состояние игры после хода)
+    GameStatus nextDay();
+
+    // Перемотка до maxDays дней без действий игрока, возвращает число
+    // прожитых дней. Пока в зоопарке спокойно (см. isQuiet), дни проходят
+    // пачкой: зарплаты, платежи по кредиту, корм и доход считаются
+    // без обхода животных по дням, популярность разыгрывается как обычно.
+    // День первого заражения разыгрывается сразу для всех вольеров
+    // (геометрическое распределение), и в этот день, как и во все
+    // неспокойные дни, зоопарк живет обычным ходом. Итог статистически
+    // такой же, как у nextDay, но случайные числа тратятся иначе
+    int fastForward(int maxDays);
+
+    // Спокойное состояние: зараженных и вспышек нет, грязных вольеров нет,
+    // уборщиков хватает на все вольеры, модель посетителей выключена
+    bool isQuiet() const;
+
+    // Проверка возможности покупки животного
+    bool canBuyAnimal() const {
+        return animalsBoughtToday < (day >= 10 ? 1 : INT_MAX);
+    }
+
+    // Увеличение счетчика купленных сегодня животных
+    void incrementAnimalsBought() {
+        animalsBoughtToday++;
+    }
+
+    // Ручное скрещивание животных
+    bool manualBreeding();
+
+    // Лечение конкретного животного
+    bool treatAnimal();
+};
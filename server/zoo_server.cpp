@@ -0,0 +1,858 @@
+// Сервер симуляции: много зоопарков в одном процессе, команды приходят по
+// Unix-сокету построчным JSON (один объект-запрос на строку, один ответ на строку)
+#include "sweep.h"
+
+#include <condition_variable>
+#include <csignal>
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// JSON: плоский объект запроса и построчная запись ответа
+// ---------------------------------------------------------------------------
+
+// Значение поля запроса
+struct JsonValue {
+    enum Kind { STRING, NUMBER, BOOL, NUL } kind = NUL;
+    string text;                // Строка (UTF-8) для STRING
+    double number = 0.0;        // Число для NUMBER и BOOL
+    string raw;                 // Исходная запись значения (для эха id)
+};
+
+using JsonObject = map<string, JsonValue>;
+
+// Разбор плоского объекта {"ключ": строка|число|true|false|null, ...}
+class JsonParser {
+private:
+    const string& s;
+    size_t i = 0;
+
+    void skipSpace() {
+        while (i < s.size() && (s[i] == ' ' || s[i] == '\t' || s[i] == '\r' || s[i] == '\n')) ++i;
+    }
+
+    bool parseString(string& out) {
+        if (i >= s.size() || s[i] != '"') return false;
+        ++i;
+        while (i < s.size() && s[i] != '"') {
+            char c = s[i++];
+            if (c != '\\') {
+                out += c;
+                continue;
+            }
+            if (i >= s.size()) return false;
+            char e = s[i++];
+            switch (e) {
+            case '"': out += '"'; break;
+            case '\\': out += '\\'; break;
+            case '/': out += '/'; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            case 'u': {
+                if (i + 4 > s.size()) return false;
+                uint32_t cp = static_cast<uint32_t>(strtoul(s.substr(i, 4).c_str(), nullptr, 16));
+                i += 4;
+                // Суррогатная пара \uD8xx\uDCxx
+                if (cp >= 0xD800 && cp <= 0xDBFF && i + 6 <= s.size() && s[i] == '\\' && s[i + 1] == 'u') {
+                    uint32_t low = static_cast<uint32_t>(strtoul(s.substr(i + 2, 4).c_str(), nullptr, 16));
+                    if (low >= 0xDC00 && low <= 0xDFFF) {
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                        i += 6;
+                    }
+                }
+                out += toUtf8(wstring(1, static_cast<wchar_t>(cp)));
+                break;
+            }
+            default: return false;
+            }
+        }
+        if (i >= s.size()) return false;
+        ++i;
+        return true;
+    }
+
+    bool parseValue(JsonValue& v) {
+        size_t start = i;
+        if (i >= s.size()) return false;
+        if (s[i] == '"') {
+            v.kind = JsonValue::STRING;
+            if (!parseString(v.text)) return false;
+        }
+        else if (s.compare(i, 4, "true") == 0 || s.compare(i, 5, "false") == 0) {
+            v.kind = JsonValue::BOOL;
+            v.number = s[i] == 't' ? 1.0 : 0.0;
+            i += s[i] == 't' ? 4 : 5;
+        }
+        else if (s.compare(i, 4, "null") == 0) {
+            v.kind = JsonValue::NUL;
+            i += 4;
+        }
+        else {
+            char* end = nullptr;
+            v.number = strtod(s.c_str() + i, &end);
+            if (end == s.c_str() + i) return false;
+            v.kind = JsonValue::NUMBER;
+            i = end - s.c_str();
+        }
+        v.raw = s.substr(start, i - start);
+        return true;
+    }
+
+public:
+    explicit JsonParser(const string& text) : s(text) {}
+
+    bool parse(JsonObject& out, string& error) {
+        skipSpace();
+        if (i >= s.size() || s[i] != '{') {
+            error = "ожидается объект";
+            return false;
+        }
+        ++i;
+        skipSpace();
+        if (i < s.size() && s[i] == '}') {
+            ++i;
+        }
+        else {
+            while (true) {
+                string key;
+                JsonValue value;
+                skipSpace();
+                if (!parseString(key)) {
+                    error = "ожидается ключ";
+                    return false;
+                }
+                skipSpace();
+                if (i >= s.size() || s[i] != ':') {
+                    error = "ожидается ':'";
+                    return false;
+                }
+                ++i;
+                skipSpace();
+                if (!parseValue(value)) {
+                    error = "неверное значение поля " + key;
+                    return false;
+                }
+                out[key] = value;
+                skipSpace();
+                if (i < s.size() && s[i] == ',') {
+                    ++i;
+                    continue;
+                }
+                if (i < s.size() && s[i] == '}') {
+                    ++i;
+                    break;
+                }
+                error = "ожидается ',' или '}'";
+                return false;
+            }
+        }
+        skipSpace();
+        if (i != s.size()) {
+            error = "лишние символы после объекта";
+            return false;
+        }
+        return true;
+    }
+};
+
+// Построчная запись JSON: запятые между элементами расставляются сами
+class JsonWriter {
+private:
+    ostringstream out;
+    vector<bool> first;         // Первый ли элемент на каждом уровне вложенности
+    bool afterKey = false;
+
+    void separate() {
+        if (afterKey) {
+            afterKey = false;
+            return;
+        }
+        if (!first.empty()) {
+            if (!first.back()) out << ',';
+            first.back() = false;
+        }
+    }
+
+    void writeString(const string& text) {
+        out << '"';
+        for (char c : text) {
+            unsigned char u = static_cast<unsigned char>(c);
+            if (c == '"' || c == '\\') out << '\\' << c;
+            else if (c == '\n') out << "\\n";
+            else if (u < 0x20) out << "\\u00" << "0123456789abcdef"[u >> 4] << "0123456789abcdef"[u & 0xF];
+            else out << c;
+        }
+        out << '"';
+    }
+
+public:
+    JsonWriter() { out << setprecision(15); }
+
+    JsonWriter& beginObject() { separate(); out << '{'; first.push_back(true); return *this; }
+    JsonWriter& endObject() { out << '}'; first.pop_back(); return *this; }
+    JsonWriter& beginArray() { separate(); out << '['; first.push_back(true); return *this; }
+    JsonWriter& endArray() { out << ']'; first.pop_back(); return *this; }
+
+    JsonWriter& key(const string& name) {
+        separate();
+        writeString(name);
+        out << ':';
+        afterKey = true;
+        return *this;
+    }
+
+    JsonWriter& value(const string& text) { separate(); writeString(text); return *this; }
+    JsonWriter& value(const wstring& text) { return value(toUtf8(text)); }
+    JsonWriter& value(const char* text) { return value(string(text)); }
+    JsonWriter& value(bool flag) { separate(); out << (flag ? "true" : "false"); return *this; }
+    JsonWriter& value(int number) { separate(); out << number; return *this; }
+    JsonWriter& value(size_t number) { separate(); out << number; return *this; }
+    JsonWriter& value(double number) {
+        separate();
+        if (std::isfinite(number)) out << number;
+        else out << "null";
+        return *this;
+    }
+    JsonWriter& rawValue(const string& json) { separate(); out << json; return *this; }
+
+    string str() const { return out.str(); }
+};
+
+// Ошибка выполнения команды (текст уходит клиенту в поле error)
+struct CommandError : runtime_error {
+    explicit CommandError(const string& message) : runtime_error(message) {}
+};
+
+// Числовое поле запроса; без значения по умолчанию поле обязательно
+double numberField(const JsonObject& req, const string& name, const double* fallback = nullptr) {
+    auto it = req.find(name);
+    if (it == req.end() || it->second.kind == JsonValue::NUL) {
+        if (fallback) return *fallback;
+        throw CommandError("нет поля " + name);
+    }
+    if (it->second.kind != JsonValue::NUMBER) throw CommandError("поле " + name + " должно быть числом");
+    return it->second.number;
+}
+
+int intField(const JsonObject& req, const string& name, int low, int high, const int* fallback = nullptr) {
+    double fb = fallback ? *fallback : 0.0;
+    double v = numberField(req, name, fallback ? &fb : nullptr);
+    if (v != floor(v) || v < low || v > high) {
+        throw CommandError("поле " + name + " должно быть целым от " + to_string(low) + " до " + to_string(high));
+    }
+    return static_cast<int>(v);
+}
+
+bool boolField(const JsonObject& req, const string& name, bool fallback) {
+    auto it = req.find(name);
+    if (it == req.end() || it->second.kind == JsonValue::NUL) return fallback;
+    if (it->second.kind != JsonValue::BOOL) throw CommandError("поле " + name + " должно быть true или false");
+    return it->second.number != 0.0;
+}
+
+string stringField(const JsonObject& req, const string& name, const string& fallback) {
+    auto it = req.find(name);
+    if (it == req.end() || it->second.kind == JsonValue::NUL) return fallback;
+    if (it->second.kind != JsonValue::STRING) throw CommandError("поле " + name + " должно быть строкой");
+    return it->second.text;
+}
+
+const char* statusName(GameStatus status) {
+    switch (status) {
+    case RUNNING: return "running";
+    case VICTORY: return "victory";
+    case BANKRUPT: return "bankrupt";
+    case DIRECTOR_LOST: return "director_lost";
+    }
+    return "unknown";
+}
+
+// ---------------------------------------------------------------------------
+// Зоопарки и их последовательное выполнение
+// ---------------------------------------------------------------------------
+
+// Зоопарк на сервере. Команды одного зоопарка выполняются строго по очереди
+// (задания лежат в jobs, running - одно из них сейчас выполняется), команды
+// разных зоопарков - параллельно в пуле потоков
+struct HostedZoo {
+    int id = 0;
+    wstring name;
+    unique_ptr<Zoo> zoo;
+    mt19937 engine;             // Генератор зоопарка (подставляется в поток на время задания)
+    deque<function<void()>> jobs;
+    bool running = false;
+};
+
+using HostedZooPtr = shared_ptr<HostedZoo>;
+
+// Пул потоков, выполняющий задания зоопарков. Зоопарк с заданиями стоит в
+// очереди ready не более одного раза, поэтому его задания не пересекаются
+class ZooExecutor {
+private:
+    mutex lock;
+    condition_variable wake;
+    deque<HostedZooPtr> ready;
+    vector<thread> threads;
+    bool stopping = false;
+
+    void work() {
+        zooQuiet() = true;
+        unique_lock<mutex> guard(lock);
+        while (true) {
+            wake.wait(guard, [this] { return stopping || !ready.empty(); });
+            if (stopping) return;
+            HostedZooPtr hosted = ready.front();
+            ready.pop_front();
+            function<void()> job = move(hosted->jobs.front());
+            hosted->jobs.pop_front();
+            guard.unlock();
+
+            zooEngine() = hosted->engine;
+            job();
+            hosted->engine = zooEngine();
+
+            guard.lock();
+            // Одно задание за раз: остальные зоопарки не ждут длинной очереди
+            if (hosted->jobs.empty()) hosted->running = false;
+            else ready.push_back(hosted);
+        }
+    }
+
+public:
+    explicit ZooExecutor(int threadCount) {
+        for (int t = 0; t < threadCount; ++t) threads.emplace_back(&ZooExecutor::work, this);
+    }
+
+    ~ZooExecutor() { stop(); }
+
+    // Остановка: текущие задания доделываются, ожидающие отбрасываются
+    void stop() {
+        {
+            lock_guard<mutex> guard(lock);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (thread& t : threads) t.join();
+        threads.clear();
+    }
+
+    void submit(const HostedZooPtr& hosted, function<void()> job) {
+        {
+            lock_guard<mutex> guard(lock);
+            hosted->jobs.push_back(move(job));
+            if (hosted->running) return;
+            hosted->running = true;
+            ready.push_back(hosted);
+        }
+        wake.notify_one();
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Команды
+// ---------------------------------------------------------------------------
+
+// Краткое состояние зоопарка (общая часть ответов)
+void writeSummary(JsonWriter& w, const Zoo& zoo) {
+    w.key("day").value(zoo.getDay());
+    w.key("status").value(statusName(zoo.getStatus()));
+    w.key("money").value(zoo.getMoney());
+    w.key("debt").value(zoo.getDebt());
+    w.key("popularity").value(zoo.getPopularity());
+    w.key("animals").value(zoo.totalAnimals());
+}
+
+void cmdStep(HostedZoo& h, const JsonObject& req, JsonWriter& w) {
+    const int maxEvents = 100;
+    int days = intField(req, "days", 1, 100000);
+    bool fast = boolField(req, "fast", false);
+    Zoo& zoo = *h.zoo;
+    vector<wstring> events;
+    zoo.setEventLog(&events);
+    int stepped = 0;
+    if (fast) {
+        stepped = zoo.fastForward(days);
+    }
+    else {
+        while (stepped < days && !zoo.isOver()) {
+            zoo.nextDay();
+            stepped++;
+        }
+    }
+    zoo.setEventLog(nullptr);
+    w.key("stepped").value(stepped);
+    writeSummary(w, zoo);
+    // Последние события; при длинном шаге старые отбрасываются
+    size_t from = events.size() > static_cast<size_t>(maxEvents) ? events.size() - maxEvents : 0;
+    w.key("events_dropped").value(from);
+    w.key("events").beginArray();
+    for (size_t i = from; i < events.size(); ++i) w.value(events[i]);
+    w.endArray();
+}
+
+void cmdBuy(HostedZoo& h, const JsonObject& req, JsonWriter& w) {
+    Zoo& zoo = *h.zoo;
+    const vector<AnimalPtr>& offers = zoo.getMarket().getAnimals();
+    if (offers.empty()) throw CommandError("рынок пуст");
+    int index = intField(req, "index", 0, static_cast<int>(offers.size()) - 1);
+    if (!zoo.canBuyAnimal()) throw CommandError("лимит покупок на сегодня исчерпан");
+    Pen* pen = nullptr;
+    if (req.count("pen")) {
+        int p = intField(req, "pen", 0, max(static_cast<int>(zoo.getPens().size()) - 1, 0));
+        if (zoo.getPens().empty() || !zoo.getPens()[p].canAdd(offers[index])) {
+            throw CommandError("животное не подходит для вольера");
+        }
+        pen = &zoo.getPens()[p];
+    }
+    else {
+        pen = zoo.findPenFor(offers[index]);
+        if (!pen) throw CommandError("нет подходящего вольера");
+    }
+    double price = zoo.buyPrice(*offers[index]);
+    AnimalPtr bought = zoo.buyFromMarket(index, *pen);
+    if (!bought) throw CommandError("недостаточно денег");
+    w.key("species").value(bought->getName());
+    w.key("price").value(price);
+    w.key("pen").value(static_cast<int>(pen - &zoo.getPens()[0]));
+    writeSummary(w, zoo);
+}
+
+void cmdBuildPen(HostedZoo& h, const JsonObject& req, JsonWriter& w) {
+    Zoo& zoo = *h.zoo;
+    int capacity = intField(req, "capacity", 1, 100000);
+    int type = intField(req, "type", HERBIVORE, CARNIVORE);
+    int climate = intField(req, "climate", TROPICAL, DESERT);
+    if (!zoo.buildPen(capacity, static_cast<AnimalType>(type), static_cast<Climate>(climate))) {
+        throw CommandError("недостаточно денег");
+    }
+    w.key("pen").value(static_cast<int>(zoo.getPens().size()) - 1);
+    writeSummary(w, zoo);
+}
+
+void cmdHire(HostedZoo& h, const JsonObject& req, JsonWriter& w) {
+    Zoo& zoo = *h.zoo;
+    const int one = 1;
+    int role = intField(req, "role", VET, FEEDER);
+    int count = intField(req, "count", 1, 10000, &one);
+    for (int k = 0; k < count; ++k) {
+        zoo.getWorkers().hire(static_cast<WorkerType>(role), WORKER_TYPES[role] + L" " + to_wstring(zoo.getWorkers().size() + 1));
+    }
+    w.key("workers").value(zoo.getWorkers().count(static_cast<WorkerType>(role)));
+    writeSummary(w, zoo);
+}
+
+void cmdFood(HostedZoo& h, const JsonObject& req, JsonWriter& w) {
+    Zoo& zoo = *h.zoo;
+    int diet = intField(req, "diet", HERBIVORE, CARNIVORE);
+    int amount = intField(req, "amount", 1, INT_MAX);
+    if (!zoo.buyFood(static_cast<AnimalType>(diet), amount)) throw CommandError("недостаточно денег");
+    w.key("food").value(zoo.getFood(static_cast<AnimalType>(diet)));
+    writeSummary(w, zoo);
+}
+
+void cmdSnapshot(HostedZoo& h, const JsonObject&, JsonWriter& w) {
+    Zoo& zoo = *h.zoo;
+    w.key("name").value(h.name);
+    writeSummary(w, zoo);
+    w.key("debt_days").value(zoo.getDebtDaysLeft());
+    w.key("food").beginArray().value(zoo.getFood(HERBIVORE)).value(zoo.getFood(CARNIVORE)).endArray();
+    w.key("workers").beginArray();
+    for (int role = 0; role < 4; ++role) w.value(zoo.getWorkers().count(static_cast<WorkerType>(role)));
+    w.endArray();
+    w.key("pens").beginArray();
+    for (const Pen& pen : zoo.getPens()) {
+        w.beginObject();
+        w.key("type").value(static_cast<int>(pen.getAllowedType()));
+        w.key("climate").value(static_cast<int>(pen.getClimate()));
+        w.key("capacity").value(pen.getCapacity());
+        w.key("animals").value(pen.getAnimalCount());
+        w.key("infected").value(pen.getInfectedCount());
+        w.key("clean").value(pen.getIsClean());
+        w.endObject();
+    }
+    w.endArray();
+    w.key("market").beginArray();
+    for (const auto& a : zoo.getMarket().getAnimals()) {
+        w.beginObject();
+        w.key("species").value(a->getName());
+        w.key("type").value(static_cast<int>(a->getType()));
+        w.key("climate").value(static_cast<int>(a->getClimate()));
+        w.key("gender").value(static_cast<int>(a->getGender()));
+        w.key("age").value(a->getAgeDays(zoo.getDay()));
+        w.key("weight").value(a->getWeight());
+        w.key("price").value(zoo.buyPrice(*a));
+        w.endObject();
+    }
+    w.endArray();
+}
+
+void cmdMetrics(HostedZoo& h, const JsonObject& req, JsonWriter& w) {
+    const MetricsRecorder& m = h.zoo->getMetrics();
+    const int zero = 0;
+    int from = intField(req, "from", 0, INT_MAX, &zero);
+    int rows = m.getRowCount();
+    from = min(from, rows);
+    w.key("from").value(from);
+    w.key("rows").value(rows - from);
+    auto column = [&](const char* name, const vector<int>& col) {
+        w.key(name).beginArray();
+        for (int r = from; r < rows; ++r) w.value(col[r]);
+        w.endArray();
+    };
+    auto columnD = [&](const char* name, const vector<double>& col) {
+        w.key(name).beginArray();
+        for (int r = from; r < rows; ++r) w.value(col[r]);
+        w.endArray();
+    };
+    column("day", m.getDays());
+    columnD("money", m.getMoney());
+    columnD("debt", m.getDebt());
+    column("popularity", m.getPopularity());
+    column("animals", m.getAnimals());
+    column("infected", m.getInfected());
+}
+
+using ZooCommand = void (*)(HostedZoo&, const JsonObject&, JsonWriter&);
+
+const map<string, ZooCommand> ZOO_COMMANDS = {
+    { "step", cmdStep },
+    { "buy", cmdBuy },
+    { "build_pen", cmdBuildPen },
+    { "hire", cmdHire },
+    { "food", cmdFood },
+    { "snapshot", cmdSnapshot },
+    { "metrics", cmdMetrics }
+};
+
+// ---------------------------------------------------------------------------
+// Сервер: цикл poll по сокетам, ответы из пула через self-pipe
+// ---------------------------------------------------------------------------
+
+volatile sig_atomic_t stopRequested = 0;
+int signalPipe = -1;
+
+void onSignal(int) {
+    stopRequested = 1;
+    char c = 0;
+    if (write(signalPipe, &c, 1) < 0) {}
+}
+
+bool setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+class ZooServer {
+private:
+    static const size_t MAX_LINE = 1 << 16; // Длиннее - клиент отключается
+
+    // Подключенный клиент
+    struct Client {
+        int fd;
+        uint64_t id;
+        string in;              // Принятые байты без последней неполной строки
+        string out;             // Еще не отправленные ответы
+    };
+
+    string socketPath;
+    int listenFd = -1;
+    int wakePipe[2] = { -1, -1 };
+    map<int, Client> clients;             // По дескриптору
+    map<uint64_t, int> clientFds;         // Номер клиента -> дескриптор
+    uint64_t nextClientId = 1;
+    map<int, HostedZooPtr> zoos;          // Только поток цикла
+    int nextZooId = 1;
+    ZooExecutor executor;
+
+    // Готовые ответы из пула (номер клиента, строка)
+    mutex doneLock;
+    vector<pair<uint64_t, string>> done;
+
+    void post(uint64_t client, const string& line) {
+        {
+            lock_guard<mutex> guard(doneLock);
+            done.emplace_back(client, line);
+        }
+        char c = 0;
+        if (write(wakePipe[1], &c, 1) < 0) {}
+    }
+
+    void send(uint64_t client, const string& line) {
+        auto it = clientFds.find(client);
+        if (it == clientFds.end()) return;   // Клиент отключился, ответ некому
+        clients[it->second].out += line;
+        clients[it->second].out += '\n';
+    }
+
+    static string errorResponse(const string& id, const string& message) {
+        JsonWriter w;
+        w.beginObject().key("id").rawValue(id).key("ok").value(false).key("error").value(message).endObject();
+        return w.str();
+    }
+
+    // Команды, не трогающие состояние зоопарков, выполняются в цикле сразу
+    void handleLine(uint64_t client, const string& line) {
+        JsonObject req;
+        string error;
+        if (!JsonParser(line).parse(req, error)) {
+            send(client, errorResponse("null", "неверный JSON: " + error));
+            return;
+        }
+        string id = req.count("id") ? req["id"].raw : "null";
+        try {
+            string cmd = stringField(req, "cmd", "");
+            if (cmd == "create") {
+                send(client, createZoo(id, req));
+            }
+            else if (cmd == "list") {
+                JsonWriter w;
+                w.beginObject().key("id").rawValue(id).key("ok").value(true).key("zoos").beginArray();
+                for (const auto& entry : zoos) {
+                    w.beginObject().key("zoo").value(entry.first).key("name").value(entry.second->name).endObject();
+                }
+                w.endArray().endObject();
+                send(client, w.str());
+            }
+            else if (cmd == "close") {
+                int zooId = intField(req, "zoo", 0, INT_MAX);
+                if (!zoos.erase(zooId)) throw CommandError("нет зоопарка " + to_string(zooId));
+                JsonWriter w;
+                w.beginObject().key("id").rawValue(id).key("ok").value(true).endObject();
+                send(client, w.str());
+            }
+            else if (ZOO_COMMANDS.count(cmd)) {
+                int zooId = intField(req, "zoo", 0, INT_MAX);
+                auto it = zoos.find(zooId);
+                if (it == zoos.end()) throw CommandError("нет зоопарка " + to_string(zooId));
+                HostedZooPtr hosted = it->second;
+                ZooCommand command = ZOO_COMMANDS.at(cmd);
+                executor.submit(hosted, [this, client, id, req, hosted, command]() {
+                    JsonWriter w;
+                    w.beginObject().key("id").rawValue(id).key("ok").value(true).key("zoo").value(hosted->id);
+                    try {
+                        command(*hosted, req, w);
+                        w.endObject();
+                        post(client, w.str());
+                    }
+                    catch (const exception& e) {
+                        post(client, errorResponse(id, e.what()));
+                    }
+                });
+            }
+            else {
+                throw CommandError("неизвестная команда " + cmd);
+            }
+        }
+        catch (const exception& e) {
+            send(client, errorResponse(id, e.what()));
+        }
+    }
+
+    // Новый зоопарк: параметры сценария берутся из полей запроса с именами
+    // параметров перебора (money, days, infection, ...)
+    string createZoo(const string& id, const JsonObject& req) {
+        Scenario sc;
+        for (const auto& field : req) {
+            const string& key = field.first;
+            if (key == "id" || key == "cmd" || key == "name" || key == "director" || key == "seed") continue;
+            if (field.second.kind != JsonValue::NUMBER || !setScenarioParam(sc, fromUtf8(key), field.second.number)) {
+                throw CommandError("неизвестный параметр " + key);
+            }
+        }
+        const double noSeed = 0.0;
+        double seed = numberField(req, "seed", &noSeed);
+        auto hosted = make_shared<HostedZoo>();
+        hosted->id = nextZooId++;
+        hosted->name = fromUtf8(stringField(req, "name", "Зоопарк " + to_string(hosted->id)));
+        // Зоопарк создается в потоке цикла со своим генератором
+        mt19937 saved = zooEngine();
+        zooSeed(seed != 0.0 ? static_cast<unsigned>(seed) : static_cast<unsigned>(time(0)) + hosted->id);
+        hosted->zoo.reset(new Zoo(hosted->name, fromUtf8(stringField(req, "director", "Директор")), sc));
+        hosted->engine = zooEngine();
+        zooEngine() = saved;
+        zoos[hosted->id] = hosted;
+
+        JsonWriter w;
+        w.beginObject().key("id").rawValue(id).key("ok").value(true).key("zoo").value(hosted->id);
+        writeSummary(w, *hosted->zoo);
+        w.endObject();
+        return w.str();
+    }
+
+    void accept() {
+        while (true) {
+            int fd = ::accept(listenFd, nullptr, nullptr);
+            if (fd < 0) return;
+            setNonBlocking(fd);
+            Client c;
+            c.fd = fd;
+            c.id = nextClientId++;
+            clientFds[c.id] = fd;
+            clients[fd] = c;
+        }
+    }
+
+    void disconnect(int fd) {
+        clientFds.erase(clients[fd].id);
+        clients.erase(fd);
+        close(fd);
+    }
+
+    // Чтение и разбор строк; false - клиент отключен
+    bool readClient(Client& c) {
+        char buffer[4096];
+        while (true) {
+            ssize_t n = read(c.fd, buffer, sizeof(buffer));
+            if (n == 0) return false;
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                return errno == EAGAIN || errno == EWOULDBLOCK;
+            }
+            c.in.append(buffer, n);
+            size_t start = 0;
+            size_t end;
+            while ((end = c.in.find('\n', start)) != string::npos) {
+                string line = c.in.substr(start, end - start);
+                start = end + 1;
+                if (!line.empty() && line.back() == '\r') line.pop_back();
+                if (!line.empty()) handleLine(c.id, line);
+            }
+            c.in.erase(0, start);
+            if (c.in.size() > MAX_LINE) return false;
+        }
+    }
+
+    bool writeClient(Client& c) {
+        while (!c.out.empty()) {
+            ssize_t n = write(c.fd, c.out.data(), c.out.size());
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                return errno == EAGAIN || errno == EWOULDBLOCK;
+            }
+            c.out.erase(0, n);
+        }
+        return true;
+    }
+
+    void drainDone() {
+        char buffer[256];
+        while (read(wakePipe[0], buffer, sizeof(buffer)) > 0) {}
+        vector<pair<uint64_t, string>> ready;
+        {
+            lock_guard<mutex> guard(doneLock);
+            ready.swap(done);
+        }
+        for (const auto& r : ready) send(r.first, r.second);
+    }
+
+public:
+    ZooServer(const string& path, int threads) : socketPath(path), executor(threads) {}
+
+    ~ZooServer() {
+        executor.stop();
+        for (auto& entry : clients) close(entry.first);
+        if (listenFd >= 0) {
+            close(listenFd);
+            unlink(socketPath.c_str());
+        }
+        if (wakePipe[0] >= 0) close(wakePipe[0]);
+        if (wakePipe[1] >= 0) close(wakePipe[1]);
+    }
+
+    bool listen(string& error) {
+        sockaddr_un addr = {};
+        addr.sun_family = AF_UNIX;
+        if (socketPath.size() >= sizeof(addr.sun_path)) {
+            error = "слишком длинный путь сокета";
+            return false;
+        }
+        strcpy(addr.sun_path, socketPath.c_str());
+        unlink(socketPath.c_str());
+        listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listenFd < 0 || bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+            ::listen(listenFd, 64) < 0 || !setNonBlocking(listenFd) || pipe(wakePipe) < 0 ||
+            !setNonBlocking(wakePipe[0]) || !setNonBlocking(wakePipe[1])) {
+            error = strerror(errno);
+            return false;
+        }
+        return true;
+    }
+
+    // Цикл событий до сигнала остановки (stopFd становится читаемым)
+    void run(int stopFd) {
+        vector<pollfd> fds;
+        while (!stopRequested) {
+            fds.clear();
+            fds.push_back({ listenFd, POLLIN, 0 });
+            fds.push_back({ wakePipe[0], POLLIN, 0 });
+            fds.push_back({ stopFd, POLLIN, 0 });
+            for (const auto& entry : clients) {
+                short events = POLLIN;
+                if (!entry.second.out.empty()) events |= POLLOUT;
+                fds.push_back({ entry.first, events, 0 });
+            }
+            if (poll(fds.data(), fds.size(), -1) < 0) {
+                if (errno == EINTR) continue;
+                break;
+            }
+            if (fds[1].revents & POLLIN) drainDone();
+            if (fds[0].revents & POLLIN) accept();
+            for (size_t k = 3; k < fds.size(); ++k) {
+                auto it = clients.find(fds[k].fd);
+                if (it == clients.end()) continue;
+                bool alive = true;
+                if (fds[k].revents & (POLLIN | POLLHUP | POLLERR)) alive = readClient(it->second);
+                if (alive) alive = writeClient(it->second);
+                if (!alive) disconnect(fds[k].fd);
+            }
+            // Ответы, появившиеся в этом проходе, отправляются сразу
+            for (auto& entry : clients) {
+                if (!entry.second.out.empty()) writeClient(entry.second);
+            }
+        }
+    }
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    string socketPath = "zoo.sock";
+    int threads = max(static_cast<int>(thread::hardware_concurrency()), 1);
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--socket" && i + 1 < argc) {
+            socketPath = argv[++i];
+        }
+        else if (arg == "--threads" && i + 1 < argc) {
+            threads = max(atoi(argv[++i]), 1);
+        }
+    }
+    setlocale(LC_ALL, "");
+    zooQuiet() = true;
+
+    int stopPipe[2];
+    if (pipe(stopPipe) < 0) return 1;
+    signalPipe = stopPipe[1];
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+    signal(SIGPIPE, SIG_IGN);
+
+    ZooServer server(socketPath, threads);
+    string error;
+    if (!server.listen(error)) {
+        fprintf(stderr, "zoo_server: %s: %s\n", socketPath.c_str(), error.c_str());
+        return 1;
+    }
+    fprintf(stderr, "zoo_server: %s, потоков: %d\n", socketPath.c_str(), threads);
+    server.run(stopPipe[0]);
+    return 0;
+}